@@ -17,7 +17,7 @@ using namespace std::chrono;
 // --- 1. Define a specialized Message for benchmarking ---
 
 struct BenchmarkPayloadMessage {
-    steady_clock::time_point creationTime;
+    uint64_t sequence = 0;
 };
 
 // --- 2. Define custom Modules for the benchmark ---
@@ -31,9 +31,12 @@ public:
     SourceModule(std::string name) : Module(std::move(name)) {}
 
     void Process(Message& _) override {
-        Message msg(BenchmarkPayloadMessage{steady_clock::now()});
+        Message msg(BenchmarkPayloadMessage{m_sequence++});
         Broadcast(msg);
     };
+
+private:
+    uint64_t m_sequence = 0;
 };
 
 /**
@@ -57,9 +60,9 @@ public:
 
     void Process(Message& msg) override {
         mMessageCount++;
-        if (auto* data = msg.BorrowPtr<BenchmarkPayloadMessage>()) {
-            auto latency = steady_clock::now() - data->creationTime;
-            mTotalLatencyNs += duration_cast<nanoseconds>(latency).count();
+        if (msg.HasType<BenchmarkPayloadMessage>()) {
+            // The ingress time is monotonic, unlike the wall-clock `timestamp`.
+            mTotalLatencyNs += Message::GetMonotonicTimestamp() - msg.GetMetaData().ingressTime;
         }
     }
 
@@ -15,7 +15,7 @@ void MockProcessModule::Process(nexusflow::Message& inputMessage) {
         // Add some data to the message
         seqMsg->addData(GetModuleName() + "_" + std::to_string(m_count++));
         LOG_INFO(GetModuleName() + ": send message: {}", seqMsg->toString());
-        Broadcast(nexusflow::MakeMessage(std::move(seqMsg)));
+        Broadcast(nexusflow::MakeMessageFrom(inputMessage, std::move(seqMsg)));
     }
 }
 
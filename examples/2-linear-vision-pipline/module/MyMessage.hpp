@@ -1,13 +1,14 @@
 #ifndef MY_MESSAGE_HPP
 #define MY_MESSAGE_HPP
 
+#include <nexusflow/Buffer.hpp>
 #include <nexusflow/Message.hpp>
 #include <sstream>
 
 // --- Base ---
 struct VideoFrame {
     uint32_t frameId;
-    std::string frameData;
+    nexusflow::Buffer frameData; // Shared by reference, copying a VideoFrame never copies pixels.
 };
 
 struct Rect {
@@ -42,7 +43,7 @@ struct DecoderMessage {
         std::ostringstream oss;
         oss << "[DecoderMessage] = {videoPackage=" << videoPackage << ", frameId=" << videoFrame.frameId
             << ", isKeyFrame=" << isKeyFrame << ", isEnd=" << isEnd << ", timestamp=" << timestamp
-            << ", videoFrame=\n\tframeId=" << videoFrame.frameId << ", frameData=" << videoFrame.frameData << "\n}";
+            << ", videoFrame=\n\tframeId=" << videoFrame.frameId << ", frameData=" << videoFrame.frameData.ToString() << "\n}";
         return oss.str();
     }
 };
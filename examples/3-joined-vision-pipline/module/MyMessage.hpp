@@ -1,13 +1,14 @@
 #ifndef MY_MESSAGE_HPP
 #define MY_MESSAGE_HPP
 
+#include <nexusflow/Buffer.hpp>
 #include <nexusflow/Message.hpp>
 #include <sstream>
 
 // --- Base ---
 struct VideoFrame {
     uint32_t frameId;
-    std::string frameData;
+    nexusflow::Buffer frameData; // Shared by reference, copying a VideoFrame never copies pixels.
 };
 
 struct Rect {
@@ -42,7 +43,7 @@ struct DecoderMessage {
         std::ostringstream oss;
         oss << "[DecoderMessage] = {videoPackage=" << videoPackage << ", frameId=" << videoFrame.frameId
             << ", isKeyFrame=" << isKeyFrame << ", isEnd=" << isEnd << ", timestamp=" << timestamp
-            << ", videoFrame=\n\tframeId=" << videoFrame.frameId << ", frameData=" << videoFrame.frameData << "\n}";
+            << ", videoFrame=\n\tframeId=" << videoFrame.frameId << ", frameData=" << videoFrame.frameData.ToString() << "\n}";
         return oss.str();
     }
 };
@@ -51,6 +52,12 @@ struct InferenceMessage {
     VideoFrame videoFrame;
     std::vector<Box> boxes; // {x0, y0, x1, y1, score, label}
 
+    // Reset hook for `nexusflow::MakePooledMessage`, releases the frame and keeps the boxes' capacity.
+    void Reset() {
+        videoFrame = VideoFrame();
+        boxes.clear();
+    }
+
     std::string toString() const {
         std::ostringstream oss;
         oss << "[InferenceMessage] = {frameId=" << videoFrame.frameId << ", boxes=[" << std::endl;
@@ -4,6 +4,7 @@
 #include "../src/utils/logging.hpp" // TODO: remove
 #include "nexusflow/ErrorCode.hpp"
 #include "nexusflow/Message.hpp"
+#include <algorithm>
 #include <thread>
 #include <type_traits>
 
@@ -17,6 +18,28 @@ MyDecoderModule::~MyDecoderModule() { LOG_TRACE("MyDecoderModule destructor, nam
 nexusflow::ErrorCode MyDecoderModule::Configure(const nexusflow::Config& config) {
     m_skipInterval = config.GetValueOrDefault("skipInterval", 25);
     LOG_INFO("MyDecoderModule::Configure, name={}, skipInterval={}", GetModuleName(), m_skipInterval);
+
+    nexusflow::BufferPoolOptions poolOptions;
+    poolOptions.bufferSize = config.GetValueOrDefault("frameBufferSize", 1920 * 1080 * 3 / 2); // NV12 1080p
+    poolOptions.initialCount = config.GetValueOrDefault("frameBufferCount", 8);
+    poolOptions.useHugePages = config.GetValueOrDefault("useHugePages", false);
+    m_framePool = nexusflow::BufferPool::Create(poolOptions);
+    if (m_framePool == nullptr) {
+        LOG_ERROR("MyDecoderModule::Configure, name={}, create frame pool failed", GetModuleName());
+        return nexusflow::ErrorCode::FAILURE;
+    }
+    return nexusflow::ErrorCode::SUCCESS;
+}
+
+nexusflow::ErrorCode MyDecoderModule::OnReconfigure(const nexusflow::Config& config) {
+    const int skipInterval = config.GetValueOrDefault("skipInterval", static_cast<int>(m_skipInterval));
+    if (skipInterval <= 0) {
+        LOG_ERROR("MyDecoderModule::OnReconfigure, name={}, invalid skipInterval={}", GetModuleName(), skipInterval);
+        return nexusflow::ErrorCode::FAILURE;
+    }
+    m_skipInterval = static_cast<uint32_t>(skipInterval);
+    LOG_INFO("MyDecoderModule::OnReconfigure, name={}, skipInterval={}", GetModuleName(), m_skipInterval);
+
     return nexusflow::ErrorCode::SUCCESS;
 }
 
@@ -25,11 +48,20 @@ void MyDecoderModule::Process(nexusflow::Message& inputMessage) {
         auto& videoPackage = msg->videoPackage;
         if (m_frameIdx % m_skipInterval == 0) {
             msg->videoFrame.frameId = m_frameIdx;
-            msg->videoFrame.frameData = "frameData-" + std::to_string(m_frameIdx);
+            // Mock decoding: write the frame into a pooled buffer, downstream modules only share it.
+            auto frameBuffer = m_framePool->Acquire();
+            if (frameBuffer.Empty()) {
+                m_frameIdx++;
+                LOG_WARN("'{}' No free frame buffer, drop frame {}", GetModuleName(), msg->videoFrame.frameId);
+                return;
+            }
+            std::string mockFrame = "frameData-" + std::to_string(m_frameIdx);
+            std::copy(mockFrame.begin(), mockFrame.end(), frameBuffer.MutableData());
+            msg->videoFrame.frameData = frameBuffer.Slice(0, mockFrame.size());
             LOG_INFO("'{}' Send message to next module, data={}", GetModuleName(), msg->toString());
 
             auto outputMessage = ConvertDecoderMessageToInferenceMessage(*msg);
-            Broadcast(nexusflow::MakeMessage(std::move(outputMessage)));
+            Broadcast(nexusflow::MakeMessageFrom(inputMessage, std::move(outputMessage)));
         }
         m_frameIdx++;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <nexusflow/BufferPool.hpp>
 #include <nexusflow/Message.hpp>
 #include <nexusflow/Module.hpp>
 
@@ -10,10 +11,14 @@ public:
 
     nexusflow::ErrorCode Configure(const nexusflow::Config& config) override;
 
+    // Applies a new `skipInterval` without a restart.
+    nexusflow::ErrorCode OnReconfigure(const nexusflow::Config& config) override;
+
 protected:
     void Process(nexusflow::Message& inputMessage) override;
 
 private:
     uint32_t m_skipInterval = 1; // skip every n-th message
     uint32_t m_frameIdx = 0; // frame index
+    std::shared_ptr<nexusflow::BufferPool> m_framePool; // decoded frames, recycled once every module is done
 };
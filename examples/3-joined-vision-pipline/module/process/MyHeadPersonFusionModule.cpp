@@ -3,8 +3,8 @@
 #include "../MyMessage.hpp"
 #include "../src/utils/logging.hpp" // TODO: remove
 #include "nexusflow/ErrorCode.hpp"
+#include "nexusflow/JoinedMessage.hpp"
 #include "nexusflow/Message.hpp"
-#include <unordered_map>
 
 MyHeadPersonFusionModule::MyHeadPersonFusionModule(const std::string& name) : Module(name) {
     LOG_TRACE("MyHeadPersonFusionModule constructor, name={}", name);
@@ -21,41 +21,45 @@ nexusflow::ErrorCode MyHeadPersonFusionModule::Configure(const nexusflow::Config
 nexusflow::ErrorCode MyHeadPersonFusionModule::Init() {
     LOG_INFO("Tring to load model from {}", m_modelPath);
 
+    // Inputs are wired before Init(), resolve their indices once.
+    m_headIndex = ResolveInput("HeadDetector");
+    m_personIndex = ResolveInput("PersonDetector");
+    if (m_headIndex < 0 || m_personIndex < 0) {
+        LOG_ERROR("'{}' needs the inputs HeadDetector and PersonDetector", GetModuleName());
+        return nexusflow::ErrorCode::FAILURE;
+    }
+
     LOG_INFO("MyHeadPersonFusionModule::Init, name={}, modelPath={}", GetModuleName(), m_modelPath);
     return nexusflow::ErrorCode::SUCCESS;
 }
 
 void MyHeadPersonFusionModule::Process(nexusflow::Message& inputMessage) {
-    const std::string headKey = "HeadDetector";
-    const std::string personKey = "PersonDetector";
-
-    using InputType = std::unordered_map<std::string, nexusflow::Message>;
-    if (auto* msg = inputMessage.MutPtr<InputType>()) {
-        for (auto& pair : *msg) {
-            LOG_DEBUG("'{}' Receive message from previous module, data={}", pair.first,
-                      pair.second.BorrowPtr<InferenceMessage>()->toString());
-        }
-
-        // Check if the input message contains the required keys
-        if (msg->find(headKey) == msg->end() || msg->find(personKey) == msg->end()) {
-            LOG_ERROR("Input message does not contain the required keys");
+    if (const auto* joined = inputMessage.BorrowPtr<nexusflow::JoinedMessage>()) {
+        // Check if the input message contains both inputs
+        if (!joined->Has(m_headIndex) || !joined->Has(m_personIndex)) {
+            LOG_ERROR("Input message does not contain the required inputs");
             return;
         }
 
-        InferenceMessage* headMessage = msg->at(headKey).MutPtr<InferenceMessage>();
-        InferenceMessage* personMessage = msg->at(personKey).MutPtr<InferenceMessage>();
+        const InferenceMessage* headMessage = joined->Get(m_headIndex).BorrowPtr<InferenceMessage>();
+        const InferenceMessage* personMessage = joined->Get(m_personIndex).BorrowPtr<InferenceMessage>();
+        LOG_DEBUG("'{}' Receive messages from previous modules, head={}, person={}", GetModuleName(), headMessage->toString(),
+                  personMessage->toString());
 
-        InferenceMessage fusedMessage = DoFusion(*headMessage, *personMessage);
+        // The fused result is recycled once the last downstream module releases it.
+        // It keeps the correlation id and times of the frame it was computed from.
+        auto outputMessage = nexusflow::MakePooledMessageFrom<InferenceMessage>(inputMessage);
+        InferenceMessage* fusedMessage = outputMessage.MutPtr<InferenceMessage>();
+        DoFusion(*headMessage, *personMessage, *fusedMessage);
 
-        LOG_INFO("'{}' Send message to next module, data={}", GetModuleName(), fusedMessage.toString());
+        LOG_INFO("'{}' Send message to next module, data={}", GetModuleName(), fusedMessage->toString());
 
-        Broadcast(nexusflow::MakeMessage(std::move(fusedMessage)));
+        Broadcast(outputMessage);
     }
 }
 
-InferenceMessage MyHeadPersonFusionModule::DoFusion(const InferenceMessage& headMessage, const InferenceMessage& personMessage) const {
-    InferenceMessage resultMessage;
-
+void MyHeadPersonFusionModule::DoFusion(const InferenceMessage& headMessage, const InferenceMessage& personMessage,
+                                        InferenceMessage& resultMessage) const {
     // or
     resultMessage.videoFrame = headMessage.videoFrame; // Assuming the video frame is the same for both messages
     // resultMessage.videoFrame = personMessage.videoFrame;
@@ -75,6 +79,4 @@ InferenceMessage MyHeadPersonFusionModule::DoFusion(const InferenceMessage& head
         resultBox.label = 0;
         resultBox.rect.x0 = resultBox.rect.y0 = resultBox.rect.x1 = resultBox.rect.y1 = 0;
     }
-
-    return resultMessage;
 }
@@ -21,8 +21,10 @@ protected:
     void Process(nexusflow::Message& inputMessage) override;
 
 private:
-    InferenceMessage DoFusion(const InferenceMessage& headMessage, const InferenceMessage& personMessage) const;
+    void DoFusion(const InferenceMessage& headMessage, const InferenceMessage& personMessage, InferenceMessage& resultMessage) const;
 
 private:
     std::string m_modelPath;
+    int m_headIndex = -1; // The index of each input in the JoinedMessage, resolved in Init().
+    int m_personIndex = -1;
 };
@@ -4,6 +4,7 @@
 #include "../src/utils/logging.hpp" // TODO: remove
 #include "nexusflow/Message.hpp"
 #include <chrono>
+#include <functional>
 #include <thread>
 
 namespace {
@@ -30,6 +31,15 @@ MyStreamPullerModule::MyStreamPullerModule(const std::string& name) : Module(nam
 
 MyStreamPullerModule::~MyStreamPullerModule() { LOG_TRACE("MyStreamPullerModule destructor, name={}", GetModuleName()); }
 
+nexusflow::ErrorCode MyStreamPullerModule::Configure(const nexusflow::Config& config) {
+    // Each camera is a stream of its own; without a configured id, pullers of different names still differ.
+    const int defaultStreamId = static_cast<int>(std::hash<std::string>()(GetModuleName()) & 0x7fffffff);
+    m_streamId = static_cast<uint64_t>(config.GetValueOrDefault("streamId", defaultStreamId));
+    LOG_INFO("MyStreamPullerModule::Configure, name={}, streamId={}", GetModuleName(), m_streamId);
+
+    return nexusflow::ErrorCode::SUCCESS;
+}
+
 void MyStreamPullerModule::Process(nexusflow::Message& inputMessage) {
     // no input message
     if (inputMessage.HasData()) {
@@ -40,5 +50,8 @@ void MyStreamPullerModule::Process(nexusflow::Message& inputMessage) {
     constexpr uint32_t kFPS = 25;
     auto msg = CreateMessage(kFPS);
     nexusflow::Message dispatchMsg(msg);
+    dispatchMsg.MetaData().streamId = m_streamId;
     Broadcast(dispatchMsg);
+    // Frames are pulled in order: no frame older than this one will follow.
+    EmitWatermark(dispatchMsg.GetMetaData().eventTime);
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 
+#include "nexusflow/ErrorCode.hpp"
+
 #include <nexusflow/Message.hpp>
 #include <nexusflow/Module.hpp>
 
+#include <cstdint>
+
 class MyStreamPullerModule : public nexusflow::Module {
     
 
@@ -11,6 +15,11 @@ public:
     MyStreamPullerModule(const std::string& name);
     ~MyStreamPullerModule() override;
 
+    nexusflow::ErrorCode Configure(const nexusflow::Config& config) override;
+
 protected:
     void Process(nexusflow::Message& inputMessage) override;
+
+private:
+    uint64_t m_streamId = 0; // Stamped on every frame, the default partition key downstream.
 };
@@ -0,0 +1,90 @@
+#ifndef NEXUSFLOW_BUFFER_HPP
+#define NEXUSFLOW_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nexusflow {
+
+class BufferPool; // Forward declaration.
+
+/**
+ * @class Buffer
+ * @brief An immutable, reference-counted view over an aligned byte slab.
+ *
+ * A Buffer is the framework's zero-copy container for large binary payloads such as
+ * decoded video frames. Copying a Buffer or taking a `Slice()` of it only increments a
+ * reference count; the bytes themselves are never duplicated. This makes a Buffer
+ * cheap to embed in message payloads: a Copy-On-Write detach of the enclosing
+ * `Message` copies the view, not the pixels.
+ *
+ * The slab is released when the last view referencing it is destroyed. Buffers
+ * acquired from a `BufferPool` are handed back to their pool instead of being freed.
+ */
+class Buffer {
+public:
+    static constexpr size_t kDefaultAlignment = 64; // One cache line.
+
+    Buffer() noexcept = default;
+
+    /**
+     * @brief Allocates a new, uniquely owned buffer on the heap.
+     * @param size The size of the buffer in bytes.
+     * @param alignment The alignment of the first byte, must be a power of two.
+     * @return The new buffer. Its content is uninitialized.
+     */
+    static Buffer Allocate(size_t size, size_t alignment = kDefaultAlignment);
+
+    /**
+     * @brief Allocates a new buffer and copies `size` bytes from `data` into it.
+     */
+    static Buffer CopyFrom(const void* data, size_t size, size_t alignment = kDefaultAlignment);
+
+    // --- Accessors ---
+    inline const uint8_t* Data() const noexcept { return m_data; }
+
+    inline size_t Size() const noexcept { return m_size; }
+
+    inline bool Empty() const noexcept { return m_size == 0; }
+
+    /**
+     * @brief Gets a writable pointer to the bytes of this view.
+     * Writing is only allowed while the underlying slab is not shared with any other
+     * Buffer, typically right after `Allocate()` or `BufferPool::Acquire()`.
+     * @return A mutable pointer, or `nullptr` if the slab is shared or the buffer is empty.
+     */
+    uint8_t* MutableData() noexcept;
+
+    /**
+     * @brief Creates a sub-view sharing the same slab.
+     * @param offset The offset of the first byte of the view, relative to this view.
+     * @param length The number of bytes in the view.
+     * @throws std::out_of_range If the requested range exceeds this view.
+     */
+    Buffer Slice(size_t offset, size_t length) const;
+
+    /**
+     * @brief Returns the number of Buffer views sharing the underlying slab.
+     */
+    long UseCount() const noexcept { return m_storage.use_count(); }
+
+    // ToString for debugging/logging, copies the bytes into a std::string.
+    std::string ToString() const { return m_data ? std::string(reinterpret_cast<const char*>(m_data), m_size) : std::string(); }
+
+private:
+    friend class BufferPool;
+
+    Buffer(std::shared_ptr<uint8_t> storage, size_t size) noexcept
+        : m_storage(std::move(storage)), m_data(m_storage.get()), m_size(size) {}
+
+    // Owns (a share of) the slab; the deleter decides whether the slab is freed or recycled.
+    std::shared_ptr<uint8_t> m_storage;
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_BUFFER_HPP
@@ -0,0 +1,71 @@
+#ifndef NEXUSFLOW_BUFFER_POOL_HPP
+#define NEXUSFLOW_BUFFER_POOL_HPP
+
+#include <nexusflow/Buffer.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace nexusflow {
+
+struct BufferPoolOptions {
+    size_t bufferSize = 0; // The size of every buffer in the pool, in bytes.
+    size_t alignment = Buffer::kDefaultAlignment; // The alignment of every buffer, a power of two.
+    size_t initialCount = 0; // The number of buffers allocated up front.
+    size_t maxCount = 0; // The maximum number of buffers alive at once, 0 means unbounded.
+    bool useHugePages = false; // Back the buffers with huge pages when the platform supports it.
+    int numaNode = -1; // Bind the buffers' memory to this NUMA node, -1 means no binding.
+};
+
+/**
+ * @class BufferPool
+ * @brief A thread-safe pool of fixed-size frame buffers.
+ *
+ * Buffers are carved out of large chunks of memory which can optionally be backed by
+ * huge pages and bound to a NUMA node. When the last `Buffer` view of a slab is
+ * destroyed, the slab goes back to the pool's free list instead of being freed, so a
+ * pipeline in steady state performs no frame allocations at all.
+ *
+ * The memory of the pool outlives the BufferPool object itself until every Buffer
+ * acquired from it has been released.
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Creates a pool with the given options.
+     * @return The new pool, or nullptr if the options are invalid.
+     */
+    static std::shared_ptr<BufferPool> Create(const BufferPoolOptions& options);
+
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Takes a buffer of `GetBufferSize()` bytes from the pool.
+     * The returned buffer is uniquely owned, so `MutableData()` can be used to fill it.
+     * @return The buffer, or an empty Buffer if the pool reached `maxCount`
+     *         or the memory could not be allocated.
+     */
+    Buffer Acquire();
+
+    // --- Getters ---
+    size_t GetBufferSize() const;
+
+    // The number of buffers currently sitting in the free list.
+    size_t GetIdleCount() const;
+
+    // The number of buffers allocated by the pool so far, idle or in use.
+    size_t GetTotalCount() const;
+
+private:
+    explicit BufferPool(const BufferPoolOptions& options);
+
+    class Impl;
+    std::shared_ptr<Impl> m_pImpl; // Shared with the deleters of outstanding buffers.
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_BUFFER_POOL_HPP
@@ -12,6 +12,7 @@ enum ErrorCode {
     FAILED_TO_STOP_WORKER,
     UNINITIALIZED_ERROR,
     FAILED_TO_OPEN_FILE,
+    INVALID_ARGUMENT,
 };
 
 } // namespace nexusflow
@@ -0,0 +1,88 @@
+#ifndef NEXUSFLOW_JOINED_MESSAGE_HPP
+#define NEXUSFLOW_JOINED_MESSAGE_HPP
+
+#include <nexusflow/Message.hpp>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace nexusflow {
+
+/**
+ * @class JoinedMessage
+ * @brief The payload a module with `syncInputs` receives: one message per input, indexed by input.
+ *
+ * The parts sit in a small fixed array, so building a joined message allocates nothing beyond
+ * the message itself, which the framework takes from an object pool. Resolve the index of
+ * each input once, in `Module::Init()`, with `Module::ResolveInput()`:
+ *
+ *     m_headIndex = ResolveInput("HeadDetector");
+ *     ...
+ *     const auto& joined = msg.Borrow<JoinedMessage>();
+ *     if (joined.Has(m_headIndex)) { use(joined.Get(m_headIndex)); }
+ *
+ * An input that did not deliver to a partial group has no part, see `Has()`.
+ */
+class JoinedMessage {
+public:
+    static constexpr size_t kMaxInputs = 8; // The largest number of inputs a join supports.
+
+    JoinedMessage() = default;
+
+    /**
+     * @throws std::length_error If `inputCount` exceeds `kMaxInputs`.
+     */
+    explicit JoinedMessage(size_t inputCount) { Resize(inputCount); }
+
+    // The number of inputs of the join.
+    inline size_t Size() const noexcept { return m_inputCount; }
+
+    // Whether the input delivered a message to this group.
+    inline bool Has(int index) const noexcept {
+        return index >= 0 && static_cast<size_t>(index) < m_inputCount && m_parts[index].HasData();
+    }
+
+    /**
+     * @brief Gets the message of an input, empty if the input did not deliver.
+     * @throws std::out_of_range If the index is not an input of the join.
+     */
+    const Message& Get(int index) const { return m_parts[CheckIndex(index)]; }
+
+    Message& Get(int index) { return m_parts[CheckIndex(index)]; }
+
+    void Set(int index, Message msg) { m_parts[CheckIndex(index)] = std::move(msg); }
+
+    /**
+     * @brief Sets the number of inputs; the parts of dropped inputs are released.
+     * @throws std::length_error If `inputCount` exceeds `kMaxInputs`.
+     */
+    void Resize(size_t inputCount) {
+        if (inputCount > kMaxInputs) {
+            throw std::length_error("A join supports at most " + std::to_string(kMaxInputs) + " inputs");
+        }
+        for (size_t idx = inputCount; idx < m_inputCount; ++idx) {
+            m_parts[idx] = Message();
+        }
+        m_inputCount = inputCount;
+    }
+
+    // The reset hook of the object pool, releases all parts.
+    void Reset() { Resize(0); }
+
+private:
+    size_t CheckIndex(int index) const {
+        if (index < 0 || static_cast<size_t>(index) >= m_inputCount) {
+            throw std::out_of_range("JoinedMessage has no input " + std::to_string(index));
+        }
+        return static_cast<size_t>(index);
+    }
+
+    std::array<Message, kMaxInputs> m_parts;
+    size_t m_inputCount = 0;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_JOINED_MESSAGE_HPP
@@ -1,6 +1,9 @@
 #ifndef NEXUSFLOW_MESSAGE_HPP
 #define NEXUSFLOW_MESSAGE_HPP
 
+#include <nexusflow/ObjectPool.hpp>
+#include <nexusflow/TypeTraits.hpp>
+
 #include <atomic>
 #include <chrono> // <-- [新增] 包含 <chrono> 头文件
 #include <cstdint>
@@ -10,7 +13,6 @@
 #include <stdexcept> // for std::runtime_error
 #include <string>
 #include <type_traits>
-#include <typeindex>
 #include <typeinfo>
 #include <vector>
 
@@ -18,8 +20,12 @@ namespace nexusflow {
 
 struct MessageMeta {
     uint64_t messageId; // The unique identifier for the message
-    uint64_t timestamp; // The timestamp when the message was created
+    uint64_t correlationId = 0; // Shared by a message and the messages derived from it, see `MakeMessageFrom`. Joins key on it.
+    uint64_t timestamp; // The wall-clock time the message was created, in ms since the epoch. For display only.
+    uint64_t ingressTime = 0; // The monotonic time the message was created, in ns. Use it for latencies and timeouts.
+    uint64_t eventTime = 0; // The time the data was sampled, in ns. Defaults to `ingressTime`, a source may set its own.
     std::string sourceName; // The name of the source of the message
+    uint64_t streamId = 0; // The stream the message belongs to, e.g. a camera; set by the source, the default partition key
 };
 
 /**
@@ -55,30 +61,85 @@ public:
 
         // Create a shared_ptr to a Model<DT> containing the data
         m_content = std::make_shared<Model<DT>>(std::forward<T>(data));
+        m_typeId = GetTypeId<DT>();
 
         m_metaData.messageId = GenerateMessageId();
+        m_metaData.correlationId = m_metaData.messageId;
         m_metaData.timestamp = GetCurrentTimestamp();
+        m_metaData.ingressTime = GetMonotonicTimestamp();
+        m_metaData.eventTime = m_metaData.ingressTime;
         m_metaData.sourceName = std::move(sourceName);
     }
 
+    /**
+     * @brief Constructs a Message whose data is taken from the process-wide object pool of `T`.
+     *
+     * When the last Message referencing the data is destroyed, the object is reset (see
+     * `ResetPooledObject`) and returned to the pool with its capacity intact, so payloads
+     * with large vectors or strings reach an allocation-free steady state. Fill the data
+     * via `MutPtr<T>()`, which does not copy since the new message is the only owner.
+     * @tparam T The type of the data. Must be default- and copy-constructible.
+     * @param sourceName The name of the source of the message.
+     */
+    template <typename T>
+    static Message CreatePooled(std::string sourceName = "") {
+        static_assert(std::is_default_constructible<T>::value, "Type must be default-constructible to be pooled.");
+        static_assert(!std::is_reference<T>::value && !std::is_pointer<T>::value, "Type must not be a reference or pointer");
+
+        Message message;
+        message.m_content = ObjectPool<Model<T>, ModelResetter<T>>::Global().Acquire();
+        message.m_typeId = GetTypeId<T>();
+        message.m_metaData.messageId = GenerateMessageId();
+        message.m_metaData.correlationId = message.m_metaData.messageId;
+        message.m_metaData.timestamp = GetCurrentTimestamp();
+        message.m_metaData.ingressTime = GetMonotonicTimestamp();
+        message.m_metaData.eventTime = message.m_metaData.ingressTime;
+        message.m_metaData.sourceName = std::move(sourceName);
+        return message;
+    }
+
     // --- Copy, Move, and Default Operations ---
-    // Default operations are perfect for COW: copying is a cheap shared_ptr copy.
+    // Copying is a cheap shared_ptr copy, perfect for COW.
     Message(const Message& other) = default;
     Message& operator=(const Message& other) = default;
-    Message(Message&& other) noexcept = default;
-    Message& operator=(Message&& other) noexcept = default;
     ~Message() = default;
 
+    // Moves must reset the cached type id, a moved-from message is empty.
+    Message(Message&& other) noexcept
+        : m_content(std::move(other.m_content)), m_typeId(other.m_typeId), m_attachments(std::move(other.m_attachments)),
+          m_metaData(std::move(other.m_metaData)) {
+        other.m_typeId = kInvalidTypeId;
+    }
+
+    Message& operator=(Message&& other) noexcept {
+        if (this != &other) {
+            m_content = std::move(other.m_content);
+            m_typeId = other.m_typeId;
+            m_attachments = std::move(other.m_attachments);
+            m_metaData = std::move(other.m_metaData);
+            other.m_typeId = kInvalidTypeId;
+        }
+        return *this;
+    }
+
     /**
      * @brief Creates an explicit deep copy of the message.
      * @return A new Message instance with its own unique copy of the data and metadata.
      */
     Message Clone() const {
-        if (!HasData()) return {};
+        if (!HasData() && !HasAttachments()) return {};
 
         Message clone;
         // Perform a deep copy of the content
-        clone.m_content = m_content->Clone();
+        clone.m_content = HasData() ? m_content->Clone() : nullptr;
+        clone.m_typeId = m_typeId;
+        // Perform a deep copy of every attachment
+        if (HasAttachments()) {
+            clone.m_attachments = std::make_shared<AttachmentTable>(*m_attachments);
+            for (auto& attachment : *clone.m_attachments) {
+                attachment.content = attachment.content->Clone();
+            }
+        }
         // Copy metadata
         clone.m_metaData = m_metaData;
         return clone;
@@ -87,15 +148,40 @@ public:
     // --- Accessors ---
     inline bool HasData() const { return m_content != nullptr; }
 
+    /**
+     * @brief Checks the type of the contained data.
+     * A single compare against the type id cached in the message, no RTTI and no virtual call.
+     */
     template <typename T>
     inline bool HasType() const {
-        return HasData() && std::type_index(typeid(T)) == m_content->getTypeIndex();
+        return m_typeId == GetTypeId<T>();
     }
 
     inline const MessageMeta& GetMetaData() const { return m_metaData; }
 
     inline MessageMeta& MetaData() { return m_metaData; }
 
+    /**
+     * @brief Marks this message as derived from `parent`, e.g. a result computed from a frame.
+     * The correlation id, the creation, ingress and event times and the stream are inherited,
+     * so joins and latency figures downstream still relate the result to its source. The
+     * message id and the source name stay this message's own.
+     */
+    void InheritMetaFrom(const Message& parent) {
+        const MessageMeta& parentMeta = parent.m_metaData;
+        m_metaData.correlationId = parentMeta.correlationId;
+        m_metaData.timestamp = parentMeta.timestamp;
+        m_metaData.ingressTime = parentMeta.ingressTime;
+        m_metaData.eventTime = parentMeta.eventTime;
+        m_metaData.streamId = parentMeta.streamId;
+    }
+
+    // The `steady_clock` time in ns, the time base of `MessageMeta::ingressTime`.
+    static uint64_t GetMonotonicTimestamp() {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    }
+
     // --- Rust-style COW Accessors: Reference and Pointer Based ---
 
     // --- Reference-based (throwing) accessors ---
@@ -104,7 +190,7 @@ public:
     const T& Borrow() const {
         if (!HasType<T>()) {
             throw std::runtime_error("Message type mismatch or empty. Requested: " + std::string(typeid(T).name()) +
-                                     ", Actual: " + (m_content ? m_content->getTypeIndex().name() : "[null]"));
+                                     ", Actual: " + (m_content ? m_content->getTypeName() : "[null]"));
         }
         return static_cast<const Model<T>*>(m_content.get())->m_data;
     }
@@ -113,7 +199,7 @@ public:
     T& Mut() {
         if (!HasType<T>()) {
             throw std::runtime_error("Message type mismatch or empty. Requested: " + std::string(typeid(T).name()) +
-                                     ", Actual: " + (m_content ? m_content->getTypeIndex().name() : "[null]"));
+                                     ", Actual: " + (m_content ? m_content->getTypeName() : "[null]"));
         }
         detach_if_shared();
         return static_cast<Model<T>*>(m_content.get())->m_data;
@@ -151,16 +237,113 @@ public:
         return &static_cast<Model<T>*>(m_content.get())->m_data;
     }
 
+    // --- Attachments: independently shared parts of a message ---
+    //
+    // A message can carry named attachments next to its main payload. Each attachment
+    // has its own reference count and its own Copy-On-Write, so mutating one part
+    // (e.g. detection boxes) never deep-copies another (e.g. a heavy video frame).
+    // Copying a Message shares the attachment table; mutating an attachment only
+    // duplicates the table of pointers and the attachment being written.
+
+    /**
+     * @brief Adds or replaces an attachment.
+     * @tparam T The type of the attachment. Must be copy-constructible, and not a reference or pointer.
+     * @param name The name of the attachment, unique within the message.
+     * @param value The value to store, moved or copied.
+     */
+    template <typename T, typename DT = typename std::decay<T>::type>
+    void SetAttachment(const std::string& name, T&& value) {
+        static_assert(std::is_copy_constructible<DT>::value, "Type must be copy-constructible for COW semantics.");
+        static_assert(!std::is_same<DT, Message>::value, "Nested messages are not supported as attachments.");
+        static_assert(!std::is_reference<DT>::value && !std::is_pointer<DT>::value, "Type must not be a reference or pointer");
+
+        detach_attachments_if_shared();
+        std::shared_ptr<Concept> content = std::make_shared<Model<DT>>(std::forward<T>(value));
+        if (auto* attachment = FindAttachment(name)) {
+            attachment->content = std::move(content);
+            attachment->typeId = GetTypeId<DT>();
+        } else {
+            m_attachments->push_back({name, GetTypeId<DT>(), std::move(content)});
+        }
+    }
+
+    /**
+     * @brief Removes an attachment.
+     * @return true if the attachment existed.
+     */
+    bool RemoveAttachment(const std::string& name) {
+        if (FindAttachment(name) == nullptr) {
+            return false;
+        }
+        detach_attachments_if_shared();
+        for (auto it = m_attachments->begin(); it != m_attachments->end(); ++it) {
+            if (it->name == name) {
+                m_attachments->erase(it);
+                break;
+            }
+        }
+        return true;
+    }
+
+    inline bool HasAttachments() const { return m_attachments != nullptr && !m_attachments->empty(); }
+
+    inline bool HasAttachment(const std::string& name) const { return FindAttachment(name) != nullptr; }
+
+    template <typename T>
+    inline bool HasAttachment(const std::string& name) const {
+        const auto* attachment = FindAttachment(name);
+        return attachment != nullptr && attachment->typeId == GetTypeId<T>();
+    }
+
+    /**
+     * @brief Borrows an immutable pointer to an attachment. Never triggers a copy.
+     * @return A const pointer to the attachment, or `nullptr` if it is missing or the type does not match.
+     */
+    template <typename T>
+    const T* BorrowAttachmentPtr(const std::string& name) const {
+        if (!HasAttachment<T>(name)) {
+            return nullptr;
+        }
+        return &static_cast<const Model<T>*>(FindAttachment(name)->content.get())->m_data;
+    }
+
+    /**
+     * @brief Gets a mutable pointer to an attachment.
+     * If the attachment is shared with another message, only this attachment is deep-copied (COW);
+     * the main payload and the other attachments stay shared.
+     * @return A mutable pointer to the attachment, or `nullptr` if it is missing or the type does not match.
+     */
+    template <typename T>
+    T* MutAttachmentPtr(const std::string& name) {
+        if (!HasAttachment<T>(name)) {
+            return nullptr;
+        }
+        detach_attachments_if_shared();
+        auto& content = FindAttachment(name)->content;
+        if (content.use_count() > 1) {
+            content = content->Clone();
+        }
+        return &static_cast<Model<T>*>(content.get())->m_data;
+    }
+
     // ToString for debugging/logging
     std::string ToString() const {
         std::ostringstream oss;
         oss << "Message ID: " << m_metaData.messageId << ", Timestamp: " << m_metaData.timestamp
             << ", Source: " << m_metaData.sourceName;
         if (m_content) {
-            oss << ", Type: " << m_content->getTypeIndex().name() << ", SharedCount: " << m_content.use_count();
+            oss << ", Type: " << m_content->getTypeName() << ", SharedCount: " << m_content.use_count();
         } else {
             oss << ", Type: [null]";
         }
+        if (HasAttachments()) {
+            oss << ", Attachments: [";
+            for (size_t idx = 0; idx < m_attachments->size(); ++idx) {
+                const auto& attachment = (*m_attachments)[idx];
+                oss << (idx > 0 ? ", " : "") << attachment.name << "(SharedCount: " << attachment.content.use_count() << ")";
+            }
+            oss << "]";
+        }
         return oss.str();
     }
 
@@ -168,7 +351,8 @@ private:
     // --- Internal Type-Erasure Implementation ---
     struct Concept {
         virtual ~Concept() = default;
-        virtual std::type_index getTypeIndex() const noexcept = 0;
+        // Only used for diagnostics, type checks compare the TypeId stored next to the content.
+        virtual const char* getTypeName() const noexcept = 0;
         virtual std::shared_ptr<Concept> Clone() const = 0; // For deep copying
     };
 
@@ -177,9 +361,10 @@ private:
         // T must be copy-constructible to support the Clone operation for COW.
         static_assert(std::is_copy_constructible<T>::value, "Type T must be copy-constructible for Message's COW feature.");
 
-        explicit Model(T data) : m_data(std::move(data)) {}
+        template <typename... Args>
+        explicit Model(Args&&... args) : m_data(std::forward<Args>(args)...) {}
 
-        std::type_index getTypeIndex() const noexcept override { return std::type_index(typeid(T)); }
+        const char* getTypeName() const noexcept override { return typeid(T).name(); }
 
         // Clone creates a new shared_ptr holding a new Model with a copy of m_data.
         std::shared_ptr<Concept> Clone() const override {
@@ -189,6 +374,12 @@ private:
         T m_data; // The actual data is stored here.
     };
 
+    // Runs the reset hook of the payload when a pooled Model goes back to its pool.
+    template <typename T>
+    struct ModelResetter {
+        void operator()(Model<T>& model) const { ResetPooledObject(model.m_data); }
+    };
+
     // --- COW Helper ---
     /**
      * @brief If the content is shared (use_count > 1), replaces it with a deep copy.
@@ -200,6 +391,39 @@ private:
         }
     }
 
+    // --- Attachment Helpers ---
+    struct Attachment {
+        std::string name;
+        TypeId typeId;
+        std::shared_ptr<Concept> content;
+    };
+    // A handful of parts per message, a flat vector beats a map for lookup and copy.
+    using AttachmentTable = std::vector<Attachment>;
+
+    Attachment* FindAttachment(const std::string& name) {
+        if (m_attachments == nullptr) return nullptr;
+        for (auto& attachment : *m_attachments) {
+            if (attachment.name == name) return &attachment;
+        }
+        return nullptr;
+    }
+
+    const Attachment* FindAttachment(const std::string& name) const {
+        return const_cast<Message*>(this)->FindAttachment(name);
+    }
+
+    /**
+     * @brief Makes the attachment table exclusive to this message before it is modified.
+     * Only the table of pointers is copied, the attachments themselves stay shared.
+     */
+    void detach_attachments_if_shared() {
+        if (m_attachments == nullptr) {
+            m_attachments = std::make_shared<AttachmentTable>();
+        } else if (m_attachments.use_count() > 1) {
+            m_attachments = std::make_shared<AttachmentTable>(*m_attachments);
+        }
+    }
+
     // --- Static Helpers ---
     static uint64_t GenerateMessageId() {
         static std::atomic<uint64_t> counter{0};
@@ -214,6 +438,10 @@ private:
 private:
     // The single shared_ptr that manages the lifetime and sharing of the internal Model object.
     std::shared_ptr<Concept> m_content;
+    // The type id of m_content, kept in the message itself so type checks need no indirection.
+    TypeId m_typeId = kInvalidTypeId;
+    // Named attachments, shared between copies of this message until one of them writes.
+    std::shared_ptr<AttachmentTable> m_attachments;
     MessageMeta m_metaData;
 };
 
@@ -223,6 +451,28 @@ static Message MakeMessage(T&& value, std::string source = "") {
     return Message(std::forward<T>(value), std::move(source));
 }
 
+// Factory function for construction from the object pool of `T`, see `Message::CreatePooled`.
+template <typename T>
+static Message MakePooledMessage(std::string source = "") {
+    return Message::CreatePooled<T>(std::move(source));
+}
+
+// Factory function for a message derived from `parent`, see `Message::InheritMetaFrom`.
+template <typename T>
+static Message MakeMessageFrom(const Message& parent, T&& value, std::string source = "") {
+    Message message(std::forward<T>(value), std::move(source));
+    message.InheritMetaFrom(parent);
+    return message;
+}
+
+// Factory function for a pooled message derived from `parent`.
+template <typename T>
+static Message MakePooledMessageFrom(const Message& parent, std::string source = "") {
+    Message message = Message::CreatePooled<T>(std::move(source));
+    message.InheritMetaFrom(parent);
+    return message;
+}
+
 } // namespace nexusflow
 
 #endif // NEXUSFLOW_MESSAGE_HPP
\ No newline at end of file
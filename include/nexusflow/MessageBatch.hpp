@@ -0,0 +1,145 @@
+#ifndef NEXUSFLOW_MESSAGE_BATCH_HPP
+#define NEXUSFLOW_MESSAGE_BATCH_HPP
+
+#include <nexusflow/Message.hpp>
+#include <nexusflow/Module.hpp>
+#include <nexusflow/Span.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace nexusflow {
+
+/**
+ * @class MessageBatch
+ * @brief A homogeneous, typed view over a batch of messages.
+ *
+ * The batch is assembled once from the type-erased `std::vector<Message>` handed over
+ * by the framework: every message holding a `T` is type-checked exactly once and its
+ * payload pointer is stored in a flat array. For trivially-copyable `T` the payloads
+ * are additionally gathered into one contiguous array, ready for SIMD-friendly loops.
+ *
+ * A MessageBatch is meant to be kept as a member and re-assembled for every batch, so
+ * its arrays keep their capacity and assembling does not allocate in steady state.
+ * The views are valid until the next `Assemble()` or until the source batch changes.
+ *
+ * @tparam T The payload type of the batch.
+ */
+template <typename T>
+class MessageBatch {
+public:
+    static constexpr bool kIsContiguous = std::is_trivially_copyable<T>::value;
+
+    /**
+     * @brief Rebuilds the typed view from a batch of messages.
+     * @param messages The batch; messages not holding a `T` are recorded as "others".
+     */
+    void Assemble(std::vector<Message>& messages) {
+        Clear();
+        m_items.reserve(messages.size());
+        m_indices.reserve(messages.size());
+        for (size_t idx = 0; idx < messages.size(); ++idx) {
+            if (const T* item = messages[idx].BorrowPtr<T>()) {
+                m_items.push_back(item);
+                m_indices.push_back(idx);
+            } else {
+                m_otherIndices.push_back(idx);
+            }
+        }
+        GatherValues(std::integral_constant<bool, kIsContiguous>());
+        m_messages = &messages;
+    }
+
+    void Clear() {
+        m_items.clear();
+        m_indices.clear();
+        m_otherIndices.clear();
+        m_values.clear();
+        m_messages = nullptr;
+    }
+
+    // --- Accessors ---
+    inline size_t Size() const { return m_items.size(); }
+
+    inline bool Empty() const { return m_items.empty(); }
+
+    // The payloads of the batch, one pointer per message holding a `T`.
+    inline Span<const T* const> Items() const { return Span<const T* const>(m_items.data(), m_items.size()); }
+
+    /**
+     * @brief The payloads of the batch, copied into one contiguous array.
+     * Only available for trivially-copyable `T`.
+     */
+    inline Span<const T> Values() const {
+        static_assert(kIsContiguous, "Values() is only available for trivially-copyable payload types.");
+        return Span<const T>(m_values.data(), m_values.size());
+    }
+
+    // The message holding the `idx`-th item, e.g. to forward it downstream.
+    inline Message& GetMessage(size_t idx) const { return (*m_messages)[m_indices[idx]]; }
+
+    // Positions, in the source batch, of the messages that do not hold a `T`.
+    inline Span<const size_t> OtherIndices() const { return Span<const size_t>(m_otherIndices.data(), m_otherIndices.size()); }
+
+private:
+    void GatherValues(std::true_type /*isContiguous*/) {
+        m_values.reserve(m_items.size());
+        for (const T* item : m_items) {
+            m_values.push_back(*item);
+        }
+    }
+
+    void GatherValues(std::false_type /*isContiguous*/) {}
+
+    std::vector<const T*> m_items;
+    std::vector<size_t> m_indices;
+    std::vector<size_t> m_otherIndices;
+    std::vector<typename std::conditional<kIsContiguous, T, char>::type> m_values;
+    std::vector<Message>* m_messages = nullptr;
+};
+
+/**
+ * @class TypedBatchModule
+ * @brief A Module that receives its batches as a typed, homogeneous `MessageBatch<T>`.
+ *
+ * The framework still hands over one `std::vector<Message>` per batch; this class
+ * assembles it into a MessageBatch once and calls `ProcessTypedBatch()`. Messages of
+ * other types are passed to `Process()` one by one, whose default implementation
+ * drops them.
+ *
+ * @tparam T The payload type processed in batches.
+ */
+template <typename T>
+class TypedBatchModule : public Module {
+public:
+    using Module::Module;
+
+    /**
+     * @brief The batch-oriented processing logic.
+     * @note Derived classes MUST implement this method.
+     * @param batch The typed view over the current batch.
+     */
+    virtual void ProcessTypedBatch(MessageBatch<T>& batch) = 0;
+
+    // Receives the messages that do not hold a `T`, drops them by default.
+    void Process(Message&) override {}
+
+    void ProcessBatch(std::vector<Message>& inputBatchMessages) override {
+        m_batch.Assemble(inputBatchMessages);
+        if (!m_batch.Empty()) {
+            ProcessTypedBatch(m_batch);
+        }
+        for (size_t idx : m_batch.OtherIndices()) {
+            Process(inputBatchMessages[idx]);
+        }
+        m_batch.Clear();
+    }
+
+private:
+    MessageBatch<T> m_batch; // Reused across batches to keep its capacity.
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_MESSAGE_BATCH_HPP
@@ -0,0 +1,56 @@
+#ifndef NEXUSFLOW_MESSAGE_PREDICATE_HPP
+#define NEXUSFLOW_MESSAGE_PREDICATE_HPP
+
+#include <nexusflow/Message.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace nexusflow {
+
+// Decides whether a message passes an edge filter, e.g. by its type or metadata.
+using MessagePredicate = std::function<bool(const Message&)>;
+
+/**
+ * @class MessagePredicateRegistry
+ * @brief A singleton registry of named message predicates.
+ *
+ * A connection's `filter` config refers to a predicate by name (`predicate: isKeyFrame`);
+ * only messages for which it returns true are enqueued on that connection.
+ */
+class MessagePredicateRegistry {
+public:
+    static MessagePredicateRegistry& GetInstance();
+
+    MessagePredicateRegistry(const MessagePredicateRegistry&) = delete;
+    void operator=(const MessagePredicateRegistry&) = delete;
+
+    /**
+     * @brief Registers a predicate under a name, replacing any previous one.
+     */
+    void Register(const std::string& predicateName, MessagePredicate predicate);
+
+    /**
+     * @brief Finds a predicate by name.
+     * @return The predicate, or an empty function if no predicate has that name.
+     */
+    MessagePredicate Find(const std::string& predicateName) const;
+
+private:
+    MessagePredicateRegistry() = default;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, MessagePredicate> m_predicates;
+};
+
+} // namespace nexusflow
+
+#define NEXUSFLOW_REGISTER_MESSAGE_PREDICATE(predicateName, predicate)                          \
+    static bool messagePredicateRegistrar_##predicateName = []() {                              \
+        nexusflow::MessagePredicateRegistry::GetInstance().Register(#predicateName, predicate); \
+        return true;                                                                            \
+    }();
+
+#endif // NEXUSFLOW_MESSAGE_PREDICATE_HPP
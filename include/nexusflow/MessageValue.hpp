@@ -0,0 +1,56 @@
+#ifndef NEXUSFLOW_MESSAGE_VALUE_HPP
+#define NEXUSFLOW_MESSAGE_VALUE_HPP
+
+#include <nexusflow/Message.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace nexusflow {
+
+// Extracts the numeric value of a message that a window aggregates, e.g. the number of detected people.
+using MessageValueExtractor = std::function<double(const Message&)>;
+
+/**
+ * @class MessageValueRegistry
+ * @brief A singleton registry of named message value extractors.
+ *
+ * The `value` config entry of a `WindowAggregateModule` names the extractor whose values
+ * it sums, averages and takes the minimum and maximum of.
+ */
+class MessageValueRegistry {
+public:
+    static MessageValueRegistry& GetInstance();
+
+    MessageValueRegistry(const MessageValueRegistry&) = delete;
+    void operator=(const MessageValueRegistry&) = delete;
+
+    /**
+     * @brief Registers an extractor under a name, replacing any previous one.
+     */
+    void Register(const std::string& valueName, MessageValueExtractor extractor);
+
+    /**
+     * @brief Finds an extractor by name.
+     * @return The extractor, or an empty function if no extractor has that name.
+     */
+    MessageValueExtractor Find(const std::string& valueName) const;
+
+private:
+    MessageValueRegistry() = default;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, MessageValueExtractor> m_extractors;
+};
+
+} // namespace nexusflow
+
+#define NEXUSFLOW_REGISTER_MESSAGE_VALUE(valueName, extractor)                          \
+    static bool messageValueRegistrar_##valueName = []() {                              \
+        nexusflow::MessageValueRegistry::GetInstance().Register(#valueName, extractor); \
+        return true;                                                                    \
+    }();
+
+#endif // NEXUSFLOW_MESSAGE_VALUE_HPP
@@ -6,8 +6,11 @@
 #include <nexusflow/Message.hpp>
 #include <nexusflow/TypeTraits.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 // --- Forward Declarations ---
 // Forward-declare internal and framework classes to keep this header clean.
@@ -15,12 +18,39 @@ namespace nexusflow { namespace dispatcher {
 class Dispatcher;
 }} // namespace nexusflow::dispatcher
 
+namespace nexusflow { namespace core {
+class Worker;
+}} // namespace nexusflow::core
+
 namespace nexusflow {
 class Pipeline;
 }
 
 namespace nexusflow {
 
+/**
+ * @class OutputPort
+ * @brief A pre-resolved handle to one downstream output of a module.
+ *
+ * Resolve a port once, typically in `Module::Init()`, with `Module::ResolveOutput()`.
+ * Sending through a port is a plain indexed push, with no hashing or string compares.
+ */
+class OutputPort {
+public:
+    OutputPort() noexcept = default;
+
+    inline bool IsValid() const noexcept { return m_index >= 0; }
+
+    inline int GetIndex() const noexcept { return m_index; }
+
+private:
+    friend class dispatcher::Dispatcher;
+
+    explicit OutputPort(int index) noexcept : m_index(index) {}
+
+    int m_index = -1;
+};
+
 /**
  * @class Module
  * @brief An abstract base class for a processing unit within a data pipeline.
@@ -50,6 +80,15 @@ public:
     // --- Lifecycle ---
     virtual ErrorCode Configure(const Config& config);
 
+    /**
+     * @brief Applies a new configuration while the pipeline runs, see `Pipeline::Reconfigure()`.
+     * Called on the module's own thread between two batches, so it may update the members that
+     * `Process` reads without any locking. Framework keys, such as `syncInputs`, `outputMode`
+     * or the join settings, only take effect when the pipeline is rebuilt.
+     * @return An ErrorCode; the default does not support reconfiguration and returns FAILURE.
+     */
+    virtual ErrorCode OnReconfigure(const Config& config);
+
     /**
      * @brief User-defined initialization logic.
      * Called by the framework once before the pipeline starts.
@@ -82,6 +121,30 @@ public:
      */
     virtual void ProcessBatch(std::vector<Message>& inputBatchMessages);
 
+    /**
+     * @brief Called when the event time of every input has advanced to `eventTime`.
+     * No message with an earlier `MessageMeta::eventTime` will arrive any more, so windows and
+     * buffers ending at or before it can be closed. It runs between batches, after the messages
+     * received before the watermark; the framework forwards the watermark downstream when it returns.
+     * @param eventTime The smallest watermark of all inputs, in ns.
+     */
+    virtual void OnWatermark(uint64_t eventTime);
+
+    /**
+     * @brief Called once a draining `Pipeline::Stop()` has processed the last message of the module's inputs.
+     * Emit what the module still holds, such as open windows, since nothing will close it any more; the
+     * modules downstream are still running. It is not called when the stop does not drain, or times out.
+     */
+    virtual void OnDrain();
+
+    /**
+     * @brief Produces one warm-up sample of a source module, see `Pipeline::WarmUp()`.
+     * Send synthetic or recorded messages with `Broadcast()` or `SendTo()`, as `Process()` would send
+     * real ones. It runs on the thread warming the pipeline up, while the module's worker is stopped.
+     * The default sends nothing, so a source that does not override it takes no part in the warm-up.
+     */
+    virtual void WarmUp();
+
     // --- Getter and Setter ---
 
     /**
@@ -94,25 +157,84 @@ protected:
     // --- Protected API for Derived Classes ---
 
     /**
-     * @brief Broadcasts a message to all connected downstream outputs.
+     * @brief Sends a message downstream according to the module's `outputMode` config.
+     * By default every connected output receives the message. With `outputMode: partition`
+     * it goes to the single output owning the message's partition key.
      * @param msg The message to be sent.
      */
     void Broadcast(const Message& msg);
 
     /**
      * @brief Sends a message to a specific downstream output.
-     * @param outputName The name of the output port to send the message to.
+     * @note Resolves the output by name on every call, prefer `SendTo(const OutputPort&, ...)`.
+     * @param outputName The name of the downstream module to send the message to.
      * @param msg The message to be sent.
      */
     void SendTo(const std::string& outputName, const Message& msg);
 
+    /**
+     * @brief Sends a message through a pre-resolved output port.
+     * @param port The port returned by `ResolveOutput()`.
+     * @param msg The message to be sent.
+     */
+    void SendTo(const OutputPort& port, const Message& msg);
+
+    /**
+     * @brief Tells every output that no message with an earlier event time will follow.
+     * Source modules emit watermarks; the framework forwards them through the other modules.
+     * @param eventTime The watermark, in ns like `MessageMeta::eventTime`.
+     */
+    void EmitWatermark(uint64_t eventTime);
+
+    /**
+     * @brief Resolves a downstream output into a port handle.
+     * Outputs are wired before `Init()` is called, so resolve ports there.
+     * @param outputName The name of the downstream module.
+     * @return The port, or an invalid port if the module has no such output.
+     */
+    OutputPort ResolveOutput(const std::string& outputName) const;
+
+    /**
+     * @brief Gets the names of all downstream outputs, in port index order. An output connected
+     * again after a disconnect takes back its former port, so this is not the order of connection.
+     */
+    std::vector<std::string> GetOutputNames() const;
+
+    /**
+     * @brief Resolves an upstream input into its index in the `JoinedMessage` of a module with `syncInputs`.
+     * Inputs are wired before `Init()` is called, so resolve them there.
+     * @param upstreamName The name of the upstream module.
+     * @return The index, or -1 if the module has no such input.
+     */
+    int ResolveInput(const std::string& upstreamName) const;
+
+    /**
+     * @brief Gets the names of all upstream inputs, in index order, which is the order of the names.
+     */
+    const std::vector<std::string>& GetInputNames() const { return m_inputNames; }
+
+    /**
+     * @brief Whether the messages being processed are warm-up samples, see `Pipeline::WarmUp()`.
+     * A module with side effects beyond its outputs, or with state spanning messages, can skip them.
+     */
+    bool IsWarmingUp() const { return m_isWarmingUp; }
+
 private:
     friend class ModuleActor;
+    friend class core::Worker; // Updates the input names when inputs change while the pipeline runs.
 
     // A private setter for the internal handle, callable only by the Pipeline.
     void SetDispatcher(const std::shared_ptr<dispatcher::Dispatcher>& dispatcher);
 
+    // Set by the Pipeline while wiring the inputs, and by the worker when they change at runtime.
+    void SetInputNames(std::vector<std::string> inputNames) { m_inputNames = std::move(inputNames); }
+
+    // Set by the Pipeline around a warm-up, while the module's worker is stopped.
+    void SetWarmingUp(bool isWarmingUp) { m_isWarmingUp = isWarmingUp; }
+
     std::string m_moduleName;
+    std::vector<std::string> m_inputNames;
+    bool m_isWarmingUp = false;
 
     // The internal dispatcher handle.
     std::shared_ptr<dispatcher::Dispatcher> m_dispatcherPtr;
@@ -78,8 +78,8 @@ private:
     // A map from class name to its corresponding creator function.
     std::unordered_map<std::string, CreatorFunc> m_creators;
 
-    // Private constructor to enforce the singleton pattern.
-    ModuleFactory() = default;
+    // Private constructor to enforce the singleton pattern. Registers the built-in modules.
+    ModuleFactory();
 };
 
 } // namespace nexusflow
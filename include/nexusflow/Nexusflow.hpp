@@ -1,13 +1,24 @@
 #ifndef NEXUSFLOW_NEXUSFLOW_HPP
 #define NEXUSFLOW_NEXUSFLOW_HPP
 
+#include <nexusflow/Buffer.hpp>
+#include <nexusflow/BufferPool.hpp>
 #include <nexusflow/ErrorCode.hpp>
+#include <nexusflow/JoinedMessage.hpp>
 #include <nexusflow/Message.hpp>
+#include <nexusflow/MessageBatch.hpp>
+#include <nexusflow/MessagePredicate.hpp>
+#include <nexusflow/MessageValue.hpp>
 #include <nexusflow/Module.hpp>
 #include <nexusflow/ModuleFactory.hpp>
+#include <nexusflow/ObjectPool.hpp>
+#include <nexusflow/PartitionKey.hpp>
 #include <nexusflow/Pipeline.hpp>
 #include <nexusflow/PipelineBuilder.hpp>
+#include <nexusflow/Span.hpp>
+#include <nexusflow/Tap.hpp>
 #include <nexusflow/TypeTraits.hpp>
+#include <nexusflow/WindowAggregate.hpp>
 #include <nexusflow/Any.hpp>
 
 #endif
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef NEXUSFLOW_OBJECT_POOL_HPP
+#define NEXUSFLOW_OBJECT_POOL_HPP
+
+#include <nexusflow/TypeTraits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace nexusflow {
+
+/**
+ * @brief Reset hook for pooled objects, runs when an object goes back to its pool.
+ *
+ * Calls `obj.Reset()` if `T` has such a member function, otherwise leaves the object
+ * untouched. A Reset() should clear the logical content but keep allocated capacity
+ * (e.g. `vector::clear()` instead of assigning a fresh vector).
+ */
+template <typename T>
+inline typename std::enable_if<has_reset_method<T>::value>::type ResetPooledObject(T& obj) {
+    obj.Reset();
+}
+
+template <typename T>
+inline typename std::enable_if<!has_reset_method<T>::value>::type ResetPooledObject(T&) {}
+
+template <typename T>
+struct PooledObjectResetter {
+    void operator()(T& obj) const { ResetPooledObject(obj); }
+};
+
+/**
+ * @class ObjectPool
+ * @brief A thread-safe pool of reusable objects handed out as `std::shared_ptr`.
+ *
+ * When the last reference to an acquired object drops, the object is reset through
+ * `Resetter` and goes back to the pool instead of being destroyed, so it keeps the
+ * capacity of its vectors and strings. The control blocks of the returned shared_ptrs
+ * are recycled as well, which makes Acquire() allocation-free in steady state.
+ *
+ * The pool's storage is shared with every outstanding object, so objects may safely
+ * outlive the ObjectPool they came from.
+ *
+ * @tparam T The pooled type, must be default-constructible.
+ * @tparam Resetter A functor `void(T&)` run on every object returned to the pool.
+ */
+template <typename T, typename Resetter = PooledObjectResetter<T>>
+class ObjectPool {
+public:
+    static constexpr size_t kDefaultMaxIdle = 64;
+
+    explicit ObjectPool(size_t maxIdle = kDefaultMaxIdle) : m_state(std::make_shared<State>(maxIdle)) {
+        static_assert(std::is_default_constructible<T>::value, "Pooled type must be default-constructible.");
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Gets the process-wide pool of this type.
+     */
+    static ObjectPool& Global() {
+        static ObjectPool instance;
+        return instance;
+    }
+
+    /**
+     * @brief Takes an idle object from the pool, or creates a new one if none is idle.
+     */
+    std::shared_ptr<T> Acquire() {
+        T* obj = m_state->TakeObject();
+        if (obj == nullptr) {
+            obj = new T();
+        }
+        // Both the deleter and the allocator keep the state alive.
+        const std::shared_ptr<State>& state = m_state;
+        return std::shared_ptr<T>(obj, Recycler{state}, BlockAllocator<T>{state});
+    }
+
+    // Sets how many idle objects the pool keeps, extra released objects are destroyed.
+    void SetMaxIdle(size_t maxIdle) {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->maxIdle = maxIdle;
+    }
+
+    size_t GetIdleCount() const {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        return m_state->idleObjects.size();
+    }
+
+private:
+    struct State {
+        explicit State(size_t maxIdle) : maxIdle(maxIdle) {}
+
+        ~State() {
+            for (T* obj : idleObjects) delete obj;
+            for (void* block : idleBlocks) ::operator delete(block);
+        }
+
+        T* TakeObject() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (idleObjects.empty()) return nullptr;
+            T* obj = idleObjects.back();
+            idleObjects.pop_back();
+            return obj;
+        }
+
+        void ReleaseObject(T* obj) {
+            // Reset outside of the lock, it may be arbitrarily expensive.
+            Resetter()(*obj);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (idleObjects.size() < maxIdle) {
+                    idleObjects.push_back(obj);
+                    return;
+                }
+            }
+            delete obj;
+        }
+
+        // Control blocks all have the same size, the first one decides which size is recycled.
+        void* AllocateBlock(size_t size) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (blockSize == 0) blockSize = size;
+                if (size == blockSize && !idleBlocks.empty()) {
+                    void* block = idleBlocks.back();
+                    idleBlocks.pop_back();
+                    return block;
+                }
+            }
+            return ::operator new(size);
+        }
+
+        void DeallocateBlock(void* block, size_t size) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (size == blockSize && idleBlocks.size() < maxIdle) {
+                    idleBlocks.push_back(block);
+                    return;
+                }
+            }
+            ::operator delete(block);
+        }
+
+        std::mutex mutex;
+        size_t maxIdle;
+        size_t blockSize = 0;
+        std::vector<T*> idleObjects;
+        std::vector<void*> idleBlocks;
+    };
+
+    struct Recycler {
+        std::shared_ptr<State> state;
+        void operator()(T* obj) const { state->ReleaseObject(obj); }
+    };
+
+    // Allocator for the shared_ptr control blocks, recycles them through the pool's state.
+    template <typename U>
+    struct BlockAllocator {
+        using value_type = U;
+
+        template <typename V>
+        struct rebind {
+            using other = BlockAllocator<V>;
+        };
+
+        explicit BlockAllocator(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+        template <typename V>
+        BlockAllocator(const BlockAllocator<V>& other) : state(other.state) {}
+
+        U* allocate(size_t n) { return static_cast<U*>(state->AllocateBlock(n * sizeof(U))); }
+
+        void deallocate(U* ptr, size_t n) { state->DeallocateBlock(ptr, n * sizeof(U)); }
+
+        template <typename V>
+        bool operator==(const BlockAllocator<V>& other) const {
+            return state == other.state;
+        }
+
+        template <typename V>
+        bool operator!=(const BlockAllocator<V>& other) const {
+            return state != other.state;
+        }
+
+        std::shared_ptr<State> state;
+    };
+
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_OBJECT_POOL_HPP
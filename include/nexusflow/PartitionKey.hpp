@@ -0,0 +1,61 @@
+#ifndef NEXUSFLOW_PARTITION_KEY_HPP
+#define NEXUSFLOW_PARTITION_KEY_HPP
+
+#include <nexusflow/Message.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace nexusflow {
+
+// Extracts the partition key of a message. Messages with equal keys go to the same output.
+using PartitionKeyExtractor = std::function<uint64_t(const Message&)>;
+
+/**
+ * @class PartitionKeyRegistry
+ * @brief A singleton registry of named partition key extractors.
+ *
+ * A module configured with `outputMode: partition` routes every message to exactly one
+ * of its outputs, chosen by consistent hashing of the message's partition key. The
+ * `partitionKey` config entry names the extractor to use; `streamId` (the default,
+ * `MessageMeta::streamId`), `messageId` and `correlationId` are always available.
+ * The framework leaves `streamId` at 0, so the sources must set it, e.g. to a camera id;
+ * derived messages inherit it from their parent.
+ */
+class PartitionKeyRegistry {
+public:
+    static PartitionKeyRegistry& GetInstance();
+
+    PartitionKeyRegistry(const PartitionKeyRegistry&) = delete;
+    void operator=(const PartitionKeyRegistry&) = delete;
+
+    /**
+     * @brief Registers an extractor under a name, replacing any previous one.
+     */
+    void Register(const std::string& keyName, PartitionKeyExtractor extractor);
+
+    /**
+     * @brief Finds an extractor by name.
+     * @return The extractor, or an empty function if no extractor has that name.
+     */
+    PartitionKeyExtractor Find(const std::string& keyName) const;
+
+private:
+    PartitionKeyRegistry();
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, PartitionKeyExtractor> m_extractors;
+};
+
+} // namespace nexusflow
+
+#define NEXUSFLOW_REGISTER_PARTITION_KEY(keyName, extractor)                               \
+    static bool partitionKeyRegistrar_##keyName = []() {                                   \
+        nexusflow::PartitionKeyRegistry::GetInstance().Register(#keyName, extractor);      \
+        return true;                                                                       \
+    }();
+
+#endif // NEXUSFLOW_PARTITION_KEY_HPP
@@ -3,10 +3,15 @@
 
 #include <nexusflow/ErrorCode.hpp>
 #include <nexusflow/Module.hpp>
+#include <nexusflow/Tap.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 // TODO 能否做不依赖Graph
 // Forward declaration
@@ -25,14 +30,152 @@ class Pipeline {
 public:
     static std::unique_ptr<Pipeline> CreateFromYaml(const std::string& configPath);
 
+    /**
+     * @brief Initializes the modules, level by level in topological order. The modules of a level do
+     * not feed each other, so they are initialized concurrently, see `SetInitParallelism()`; the time
+     * each takes is logged. Modules of one level must not share unsynchronized state in `Init()`.
+     */
     ErrorCode Init();
 
+    /**
+     * @brief Limits how many modules of a level `Init()` and `DeInit()` run at once, 0 (the default) means all.
+     * A YAML graph sets it with the `initParallelism` key of its `graph` section.
+     */
+    void SetInitParallelism(size_t maxParallelism);
+
+    /**
+     * @brief Drives warm-up samples through the pipeline before it goes live, so the first real message
+     * meets grown pools, warm caches and lazily initialized models. Call after `Init()`, before `Start()`.
+     *
+     * Every source sends `sampleCount` samples from `Module::WarmUp()`, in rounds of one sample per
+     * source; a round is sent once the previous one left the queues. The other modules process them
+     * like real messages, see `Module::IsWarmingUp()`, but those without outputs discard them, so no
+     * sample leaves the pipeline. The pipeline is then stopped as by `Stop()`, and the load figures,
+     * the connection filters and the watermarks are reset.
+     *
+     * @param timeout How long the warm-up may take in total; the samples still in flight then are discarded.
+     * @return FAILURE if not every sample was processed in time; the pipeline can be started either way.
+     */
+    ErrorCode WarmUp(size_t sampleCount, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000));
+
+    // Starts the workers, consumers before producers, so the first messages find their consumers running.
     ErrorCode Start();
 
-    ErrorCode Stop();
-
+    /**
+     * @brief Stops the pipeline, level by level in topological order.
+     *
+     * The sources stop first. With `drain`, each following level then processes what is left in
+     * its inputs before it stops, so no message in flight is lost; the workers of a level drain
+     * in parallel. Once `timeout` has passed, the remaining workers stop right away and the
+     * messages left in their inputs are discarded and logged.
+     *
+     * A drained module then emits what it still holds: a join emits its pending groups as its
+     * policy would at their timeout, and `Module::OnDrain()` closes open windows. Messages a join
+     * drops on the way, or holds when it stops without draining, count as discarded.
+     *
+     * @param drain Process the messages in flight before stopping, or stop every worker at once.
+     * @param timeout How long draining may take in total.
+     * @param discardedCount Receives the number of messages left unprocessed, in the inputs or in joins, if not null.
+     */
+    ErrorCode Stop(bool drain = true, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                   size_t* discardedCount = nullptr);
+
+    // De-initializes the modules, level by level in reverse topological order, concurrently within a level like `Init()`.
     ErrorCode DeInit();
 
+    /**
+     * @brief Adds modules and connections, also while the pipeline runs; the other modules keep running.
+     *
+     * Connections may lead from and to modules already in the pipeline. The new modules are wired,
+     * initialized and, if the pipeline runs, started, consumers first; a running module only sends
+     * to a new one once it runs. A running module can gain an input unless it joins its inputs or
+     * runs as a source. Nothing changes if a connection is invalid or would close a cycle; if a new
+     * module fails to initialize, the subgraph is removed again.
+     *
+     * Running modules keep the output ports they resolved in Init; they reach new outputs through
+     * `Broadcast()` or by name.
+     */
+    ErrorCode AddSubgraph(const std::vector<std::shared_ptr<Module>>& modules,
+                          const std::vector<std::pair<std::string, std::string>>& connections);
+
+    /**
+     * @brief Removes modules and all their connections, also while the pipeline runs.
+     *
+     * Upstream modules stop sending to the removed ones first. The removed modules then drain their
+     * inputs level by level, as on `Stop()`, and the modules downstream of them process what they
+     * sent before their inputs are removed. What is left when `timeout` passes is discarded and
+     * logged. Connections read from a multicast ring, and the inputs of a running module that joins
+     * them, cannot be removed.
+     *
+     * @param discardedCount Receives the number of messages discarded, if not null.
+     */
+    ErrorCode RemoveSubgraph(const std::vector<std::string>& moduleNames,
+                             std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                             size_t* discardedCount = nullptr);
+
+    // Removes one module, see `RemoveSubgraph()`.
+    ErrorCode RemoveModule(const std::string& moduleName, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                           size_t* discardedCount = nullptr);
+
+    /**
+     * @brief Connects two modules of the pipeline, also while it runs, see `AddSubgraph()`.
+     * @param edgeConfig The connection's config, like in `PipelineBuilder::Connect()`.
+     */
+    ErrorCode Connect(const std::string& srcModuleName, const std::string& dstModuleName, const Config& edgeConfig = Config());
+
+    /**
+     * @brief Removes a connection, also while the pipeline runs. The downstream module processes the
+     * messages already sent through it until `timeout` passes, see `RemoveSubgraph()`.
+     */
+    ErrorCode Disconnect(const std::string& srcModuleName, const std::string& dstModuleName,
+                         std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Hands a new config to a running module, without a restart.
+     * The module receives it in `Module::OnReconfigure()`, on its own thread between two batches;
+     * the outcome is logged. A config posted before the previous one was delivered replaces it.
+     * @return FAILURE if there is no such module.
+     */
+    ErrorCode Reconfigure(const std::string& moduleName, const Config& config);
+
+    /**
+     * @brief Watches a YAML graph file and reconfigures every module whose `config` section changed in it.
+     * The file is read every `interval`. Changes to anything but the module configs, such as added
+     * modules or connections, are not applied. Replaces any file watched before.
+     * @return FAILURE if the file cannot be read or parsed.
+     */
+    ErrorCode WatchConfigFile(const std::string& configPath,
+                              std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+
+    // Stops watching the config file, if any.
+    void StopWatchingConfigFile();
+
+    /**
+     * @brief Attaches a tap to a module's output, observing every message the module sends.
+     *
+     * Taps can be attached and detached while the pipeline runs. A module without taps pays
+     * a single relaxed atomic load per message; a tapped module hands each sampled message
+     * to the tap without ever waiting, dropping it when the tap is behind.
+     *
+     * @param moduleName The name of the module whose output is tapped.
+     * @param buffer The bounded buffer receiving the observed messages.
+     * @param sampleEveryN The tap receives one of every N messages.
+     * @return The id of the tap, or `kInvalidTapId` if there is no such module.
+     */
+    TapId AttachTap(const std::string& moduleName, const std::shared_ptr<TapBuffer>& buffer, uint32_t sampleEveryN = 1);
+
+    /**
+     * @brief Attaches a tap calling a callback for the observed messages.
+     * The callback runs on a thread of its own, fed by a bounded buffer of `capacity` messages.
+     * @return The id of the tap, or `kInvalidTapId` if there is no such module.
+     */
+    TapId AttachTap(const std::string& moduleName, TapCallback callback, uint32_t sampleEveryN = 1, size_t capacity = 64);
+
+    /**
+     * @brief Detaches a tap. Messages still buffered for a callback tap are discarded.
+     */
+    ErrorCode DetachTap(TapId tapId);
+
     ~Pipeline();
 
 private:
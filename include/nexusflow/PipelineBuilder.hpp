@@ -1,6 +1,7 @@
 #ifndef NEXUSFLOW_PIPELINE_BUILDER_HPP
 #define NEXUSFLOW_PIPELINE_BUILDER_HPP
 
+#include <nexusflow/Config.hpp>
 #include <nexusflow/Module.hpp>
 
 #include <memory>
@@ -47,6 +48,15 @@ public:
      */
     PipelineBuilder& Connect(const std::string& srcModuleName, const std::string& dstModuleName);
 
+    /**
+     * @brief Defines a connection with a per-connection config, such as an edge filter.
+     * @param srcModuleName The name of the source module.
+     * @param dstModuleName The name of the destination module.
+     * @param edgeConfig The connection's config, with the keys of a YAML connection's `filter` map.
+     * @return A reference to this builder for chaining.
+     */
+    PipelineBuilder& Connect(const std::string& srcModuleName, const std::string& dstModuleName, const Config& edgeConfig);
+
     /**
      * @brief Builds the Pipeline instance from the defined configuration.
      * This method consumes the builder. After calling build(), the builder
@@ -0,0 +1,48 @@
+#ifndef NEXUSFLOW_SPAN_HPP
+#define NEXUSFLOW_SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace nexusflow {
+
+/**
+ * @class Span
+ * @brief A non-owning view over a contiguous sequence, a C++14 subset of std::span.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+    template <typename U, typename Alloc>
+    Span(std::vector<U, Alloc>& vec) noexcept : m_data(vec.data()), m_size(vec.size()) {}
+
+    template <typename U, typename Alloc>
+    Span(const std::vector<U, Alloc>& vec) noexcept : m_data(vec.data()), m_size(vec.size()) {}
+
+    constexpr T* data() const noexcept { return m_data; }
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+    T& operator[](size_t idx) const {
+        assert(idx < m_size && "Span index out of range");
+        return m_data[idx];
+    }
+
+    constexpr iterator begin() const noexcept { return m_data; }
+    constexpr iterator end() const noexcept { return m_data + m_size; }
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_SPAN_HPP
@@ -0,0 +1,69 @@
+#ifndef NEXUSFLOW_TAP_HPP
+#define NEXUSFLOW_TAP_HPP
+
+#include <nexusflow/Message.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace nexusflow {
+
+// Identifies an attached tap, see `Pipeline::AttachTap()`.
+using TapId = uint64_t;
+constexpr TapId kInvalidTapId = 0;
+
+// Receives the messages of a callback tap, on a thread of its own.
+using TapCallback = std::function<void(const Message&)>;
+
+/**
+ * @class TapBuffer
+ * @brief A bounded buffer receiving the messages observed by a tap.
+ *
+ * The producing module never waits for a tap: when the buffer is full, new messages are
+ * dropped and counted instead. The buffer holds shared references, so tapping a message
+ * does not copy its data.
+ */
+class TapBuffer {
+public:
+    /**
+     * @brief Creates a buffer holding up to `capacity` messages.
+     */
+    static std::shared_ptr<TapBuffer> Create(size_t capacity);
+
+    ~TapBuffer();
+
+    TapBuffer(const TapBuffer&) = delete;
+    TapBuffer& operator=(const TapBuffer&) = delete;
+
+    /**
+     * @brief Adds a message without blocking.
+     * @return true if added, false if the buffer is full and the message was dropped.
+     */
+    bool TryPush(const Message& msg);
+
+    bool TryPop(Message& msg);
+
+    /**
+     * @brief Pops a message, waiting up to the given timeout for one to arrive.
+     * @return true if a message was popped, false on timeout.
+     */
+    bool WaitAndPopFor(Message& msg, std::chrono::milliseconds timeout);
+
+    size_t GetSize() const;
+
+    // The number of messages dropped because the buffer was full.
+    uint64_t GetDroppedCount() const;
+
+private:
+    explicit TapBuffer(size_t capacity);
+
+    class Impl;
+    std::unique_ptr<Impl> m_pImpl;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_TAP_HPP
@@ -2,6 +2,7 @@
 #define NEXUS_FLOW_TYPE_TRAITS_HPP
 
 #include <type_traits>
+#include <utility>
 
 namespace nexusflow {
 
@@ -11,6 +12,46 @@ struct is_any_of : std::false_type {};
 template <typename T, typename First, typename... Rest>
 struct is_any_of<T, First, Rest...> : std::conditional<std::is_same<T, First>::value, std::true_type, is_any_of<T, Rest...>>::type {};
 
+// C++14 stand-in for std::void_t.
+template <typename... Ts>
+struct make_void {
+    using type = void;
+};
+template <typename... Ts>
+using void_t = typename make_void<Ts...>::type;
+
+// Detects a member function `void Reset()`, used as the reset hook of pooled objects.
+template <typename T, typename = void>
+struct has_reset_method : std::false_type {};
+
+template <typename T>
+struct has_reset_method<T, void_t<decltype(std::declval<T&>().Reset())>> : std::true_type {};
+
+/**
+ * @brief A per-type identifier that is a compile-time constant.
+ *
+ * The id of `T` is the address of a static tag instantiated for `T`, so comparing two
+ * ids is a single pointer compare, with no RTTI and no virtual call. Ids are unique
+ * within one binary; cv-qualifiers are ignored like `typeid` does.
+ */
+using TypeId = const void*;
+
+constexpr TypeId kInvalidTypeId = nullptr;
+
+namespace detail {
+template <typename T>
+struct TypeIdTag {
+    static constexpr char kTag = 0;
+};
+template <typename T>
+constexpr char TypeIdTag<T>::kTag;
+} // namespace detail
+
+template <typename T>
+constexpr TypeId GetTypeId() noexcept {
+    return &detail::TypeIdTag<typename std::remove_cv<T>::type>::kTag;
+}
+
 } // namespace nexusflow
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef NEXUSFLOW_WINDOW_AGGREGATE_HPP
+#define NEXUSFLOW_WINDOW_AGGREGATE_HPP
+
+#include <algorithm>
+#include <cstdint>
+
+namespace nexusflow {
+
+/**
+ * @struct WindowAggregate
+ * @brief The payload a `WindowAggregateModule` emits when a window closes.
+ *
+ * Time windows span `[windowStart, windowEnd)`. Count windows and sessions span the
+ * event times of their first and last message, both included. All times are event
+ * times in ns, see `MessageMeta::eventTime`.
+ */
+struct WindowAggregate {
+    uint64_t key = 0; // The window key, 0 for a module without `keyBy`.
+    uint64_t windowStart = 0;
+    uint64_t windowEnd = 0;
+    uint64_t count = 0; // The number of messages in the window.
+    double sum = 0.0; // The sum, minimum and maximum of their values, 0 for a module without `value`.
+    double min = 0.0;
+    double max = 0.0;
+
+    inline double Mean() const noexcept { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+
+    // Adds the values of another, disjoint set of messages.
+    inline void Merge(const WindowAggregate& other) noexcept {
+        if (other.count == 0) {
+            return;
+        }
+        min = count > 0 ? std::min(min, other.min) : other.min;
+        max = count > 0 ? std::max(max, other.max) : other.max;
+        count += other.count;
+        sum += other.sum;
+    }
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_WINDOW_AGGREGATE_HPP
@@ -2,7 +2,9 @@
 #define NEXUSFLOW_BASE_DEFINE_HPP
 
 #include "common/ConcurrentQueue.hpp"
+#include "common/MulticastRing.hpp"
 #include "nexusflow/Message.hpp"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 
@@ -14,8 +16,22 @@ using MessageQueue     = ConcurrentQueue<Message>;
 using MessageQueuePtr  = std::shared_ptr<MessageQueue>;
 using MessageQueueUPtr = std::unique_ptr<MessageQueue>;
 
+// Type alias for the internal broadcast ring of multicast outputs.
+using MessageRing       = MulticastRing<Message>;
+using MessageRingReader = MessageRing::Reader;
+using MessageRingUPtr   = std::unique_ptr<MessageRing>;
+
 // clang-format on
 
+/**
+ * @brief The payload of a watermark, an in-band control message sent by `Module::EmitWatermark()`.
+ * It tells the receiver that no message with an earlier event time will follow on the connection.
+ * Workers consume watermarks, modules only see them through `Module::OnWatermark()`.
+ */
+struct Watermark {
+    uint64_t eventTime = 0; // In ns, like `MessageMeta::eventTime`.
+};
+
 } // namespace nexusflow
 
 #endif // NEXUSFLOW_BASE_DEFINE_HPP
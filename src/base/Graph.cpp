@@ -7,13 +7,83 @@
 #include <unordered_map>
 #include <unordered_set>
 
-void Graph::addEdge(const std::shared_ptr<Node>& srcNodePtr, const std::shared_ptr<Node>& dstNodePtr) {
+void Graph::addEdge(const std::shared_ptr<Node>& srcNodePtr, const std::shared_ptr<Node>& dstNodePtr,
+                    const nexusflow::Config& edgeConfig) {
     if (srcNodePtr == nullptr || dstNodePtr == nullptr) return;
 
     m_nodeMap[srcNodePtr->name] = srcNodePtr;
     m_nodeMap[dstNodePtr->name] = dstNodePtr;
 
     m_adjList[srcNodePtr].emplace_back(dstNodePtr);
+
+    if (!edgeConfig.GetConfigMap().empty()) {
+        m_edgeConfigMap[srcNodePtr->name + " -> " + dstNodePtr->name] = edgeConfig;
+    }
+}
+
+void Graph::addNode(const std::shared_ptr<Node>& nodePtr) {
+    if (nodePtr != nullptr) {
+        m_nodeMap[nodePtr->name] = nodePtr;
+    }
+}
+
+bool Graph::removeNode(const std::string& name) {
+    auto nodePtr = findNode(name);
+    if (nodePtr == nullptr) {
+        return false;
+    }
+    m_adjList.erase(nodePtr);
+    for (auto& entry : m_adjList) {
+        auto& neighbors = entry.second;
+        neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), nodePtr), neighbors.end());
+    }
+    for (auto it = m_edgeConfigMap.begin(); it != m_edgeConfigMap.end();) {
+        const auto sepPos = it->first.find(" -> ");
+        if (it->first.compare(0, sepPos, name) == 0 || it->first.compare(sepPos + 4, std::string::npos, name) == 0) {
+            it = m_edgeConfigMap.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_nodeMap.erase(name);
+    return true;
+}
+
+bool Graph::removeEdge(const std::string& srcName, const std::string& dstName) {
+    auto srcNodePtr = findNode(srcName);
+    auto dstNodePtr = findNode(dstName);
+    auto iter = srcNodePtr != nullptr ? m_adjList.find(srcNodePtr) : m_adjList.end();
+    if (iter == m_adjList.end()) {
+        return false;
+    }
+    auto& neighbors = iter->second;
+    auto newEnd = std::remove(neighbors.begin(), neighbors.end(), dstNodePtr);
+    if (newEnd == neighbors.end()) {
+        return false;
+    }
+    neighbors.erase(newEnd, neighbors.end());
+    m_edgeConfigMap.erase(srcName + " -> " + dstName);
+    return true;
+}
+
+std::shared_ptr<Node> Graph::findNode(const std::string& name) const {
+    auto iter = m_nodeMap.find(name);
+    return iter != m_nodeMap.end() ? iter->second : nullptr;
+}
+
+bool Graph::hasEdge(const std::string& srcName, const std::string& dstName) const {
+    auto srcNodePtr = findNode(srcName);
+    auto iter = srcNodePtr != nullptr ? m_adjList.find(srcNodePtr) : m_adjList.end();
+    if (iter == m_adjList.end()) {
+        return false;
+    }
+    return std::any_of(iter->second.begin(), iter->second.end(),
+                       [&dstName](const std::shared_ptr<Node>& neighbor) { return neighbor->name == dstName; });
+}
+
+nexusflow::Config Graph::getEdgeConfig(const std::string& srcName, const std::string& dstName) const {
+    auto iter = m_edgeConfigMap.find(srcName + " -> " + dstName);
+    return iter != m_edgeConfigMap.end() ? iter->second : nexusflow::Config();
 }
 
 bool Graph::hasCycle() const { return checkCycleAndConvertToEdgeList(nullptr).first; }
@@ -22,6 +92,54 @@ std::vector<Edge> Graph::toEdgeListBFS(const std::shared_ptr<Node>& inputNodePtr
     return checkCycleAndConvertToEdgeList(inputNodePtr).second;
 }
 
+std::vector<std::vector<std::string>> Graph::toTopologicalLevels() const {
+    std::unordered_map<std::shared_ptr<Node>, int> inDegree;
+    for (const auto& entry : m_nodeMap) {
+        inDegree.emplace(entry.second, 0);
+    }
+    for (const auto& entry : m_adjList) {
+        for (const auto& neighbor : entry.second) {
+            inDegree[neighbor]++;
+        }
+    }
+
+    std::vector<std::shared_ptr<Node>> frontier;
+    for (const auto& entry : inDegree) {
+        if (entry.second == 0) {
+            frontier.push_back(entry.first);
+        }
+    }
+
+    // Kahn's algorithm, one level at a time: a node joins the level after the one that removed its last in-edge.
+    std::vector<std::vector<std::string>> levels;
+    size_t visitedCount = 0;
+    while (!frontier.empty()) {
+        std::vector<std::shared_ptr<Node>> nextFrontier;
+        std::vector<std::string> level;
+        for (const auto& node : frontier) {
+            level.push_back(node->name);
+            auto iter = m_adjList.find(node);
+            if (iter == m_adjList.end()) {
+                continue;
+            }
+            for (const auto& neighbor : iter->second) {
+                if (--inDegree[neighbor] == 0) {
+                    nextFrontier.push_back(neighbor);
+                }
+            }
+        }
+        visitedCount += level.size();
+        std::sort(level.begin(), level.end());
+        levels.push_back(std::move(level));
+        frontier = std::move(nextFrontier);
+    }
+
+    if (visitedCount != inDegree.size()) {
+        return {}; // A cycle.
+    }
+    return levels;
+}
+
 std::pair<bool, std::vector<Edge>> Graph::checkCycleAndConvertToEdgeList(const std::shared_ptr<Node>& inputNodePtr) const {
     std::vector<Edge> edgeList;
     std::unordered_map<std::shared_ptr<Node>, int> inDegree;
@@ -71,7 +189,8 @@ std::pair<bool, std::vector<Edge>> Graph::checkCycleAndConvertToEdgeList(const s
                 // 2. 边列表构建：这部分逻辑只对唯一的邻居执行一次。
                 //    我们检查这个邻居是否在本次循环中被处理过。
                 if (processedNeighbors.find(neighbor) == processedNeighbors.end()) {
-                    edgeList.push_back({node, neighbor});
+                    auto configIt = m_edgeConfigMap.find(node->name + " -> " + neighbor->name);
+                    edgeList.push_back({node, neighbor, configIt != m_edgeConfigMap.end() ? configIt->second : nexusflow::Config()});
                     processedNeighbors.insert(neighbor); // 标记为已处理
                 }
             }
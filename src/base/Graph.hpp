@@ -38,6 +38,7 @@ struct NodeWithModulePtr : Node {
 
 struct Edge {
     std::weak_ptr<Node> srcNodePtr, dstNodePtr;
+    nexusflow::Config config{}; // The per-connection config, e.g. an edge filter.
 };
 
 // DAG based on adjacency list representation, thread unsafe.
@@ -46,8 +47,27 @@ public:
     // Type alias for the adjacency list.
     using AdjacencyList = std::unordered_map<std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>>;
 
-    // Adds an edge from the source node to the destination node.
-    void addEdge(const std::shared_ptr<Node>& srcNodePtr, const std::shared_ptr<Node>& dstNodePtr);
+    // Adds an edge from the source node to the destination node, with an optional per-connection config.
+    void addEdge(const std::shared_ptr<Node>& srcNodePtr, const std::shared_ptr<Node>& dstNodePtr,
+                 const nexusflow::Config& edgeConfig = nexusflow::Config());
+
+    // Adds a node without edges; a node with the same name is replaced.
+    void addNode(const std::shared_ptr<Node>& nodePtr);
+
+    // Removes a node and all its edges. Returns false if there is no such node.
+    bool removeNode(const std::string& name);
+
+    // Removes the edge from `srcName` to `dstName`. Returns false if there is no such edge.
+    bool removeEdge(const std::string& srcName, const std::string& dstName);
+
+    // Finds a node by name, null if there is none.
+    std::shared_ptr<Node> findNode(const std::string& name) const;
+
+    // Whether there is an edge from `srcName` to `dstName`.
+    bool hasEdge(const std::string& srcName, const std::string& dstName) const;
+
+    // Gets the per-connection config of an edge, empty if it has none.
+    nexusflow::Config getEdgeConfig(const std::string& srcName, const std::string& dstName) const;
 
     // Checks if the graph has a cycle.
     bool hasCycle() const;
@@ -55,6 +75,10 @@ public:
     // Converts the graph to a list of edges.
     std::vector<Edge> toEdgeListBFS(const std::shared_ptr<Node>& inputNodePtr = nullptr) const;
 
+    // Groups the node names by topological level: the sources first, then every node one level after its
+    // latest upstream node, so the nodes of a level never feed each other. Sorted within a level, empty on a cycle.
+    std::vector<std::vector<std::string>> toTopologicalLevels() const;
+
 public:
     // Checks if the graph is empty.
     inline bool isEmpty() const { return m_name.empty() || m_nodeMap.empty() || m_adjList.empty(); }
@@ -69,6 +93,11 @@ public:
 
     const std::string& getName() const { return m_name; }
 
+    // The graph-level options, such as `initParallelism`.
+    void setConfig(nexusflow::Config config) { m_config = std::move(config); }
+
+    const nexusflow::Config& getConfig() const { return m_config; }
+
 private:
     // Checks if the graph has a cycle and converts the graph to a list of edges using BFS.
     std::pair<bool, std::vector<Edge>> checkCycleAndConvertToEdgeList(const std::shared_ptr<Node>& inputNodePtr) const;
@@ -76,9 +105,15 @@ private:
     // Name of the graph.
     std::string m_name;
 
+    // Graph-level options.
+    nexusflow::Config m_config;
+
     // Map of node names to node pointers.
     std::unordered_map<std::string, std::shared_ptr<Node>> m_nodeMap;
 
     // Adjacency list representing the graph.
     AdjacencyList m_adjList;
+
+    // Map of edge names ("src -> dst") to their per-connection configs, only for edges that have one.
+    std::unordered_map<std::string, nexusflow::Config> m_edgeConfigMap;
 };
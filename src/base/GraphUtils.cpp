@@ -97,6 +97,19 @@ nexusflow::Any convertYamlNodeToAny(const YAML::Node& node) {
     }
 }
 
+// Parses the `config` section of a module, an absent section is an empty config.
+nexusflow::Config parseModuleConfig(const YAML::Node& moduleNode) {
+    nexusflow::Config config;
+    const YAML::Node& configsNode = moduleNode["config"];
+    if (configsNode && configsNode.IsMap()) {
+        for (const auto& kv : configsNode) {
+            std::string key = kv.first.as<std::string>();
+            config.Add(key, convertYamlNodeToAny(kv.second));
+        }
+    }
+    return config;
+}
+
 std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath) {
     try {
         YAML::Node root = YAML::LoadFile(configPath);
@@ -117,6 +130,15 @@ std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath) {
         graph->setName(graph_yaml["name"].as<std::string>());
         LOG_INFO("Start creating graph '{}' from config: {}", graph->getName(), configPath);
 
+        // The other scalar keys of the section are graph-level options, such as `initParallelism`.
+        nexusflow::Config graphConfig;
+        for (const auto& kv : graph_yaml) {
+            if (kv.second.IsScalar()) {
+                graphConfig.Add(kv.first.as<std::string>(), convertYamlNodeToAny(kv.second));
+            }
+        }
+        graph->setConfig(std::move(graphConfig));
+
         // 2. 创建所有节点
         std::unordered_map<std::string, std::shared_ptr<Node>> tempNodeMap;
         const YAML::Node& modules_yaml = graph_yaml["modules"];
@@ -130,14 +152,7 @@ std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath) {
             std::string moduleClassName = module_item["class"].as<std::string>();
 
             // parse custom config.
-            nexusflow::Config config;
-            const YAML::Node& configsNode = module_item["config"];
-            if (configsNode && configsNode.IsMap()) {
-                for (const auto& kv : configsNode) {
-                    std::string key = kv.first.as<std::string>();
-                    config.Add(key, convertYamlNodeToAny(kv.second));
-                }
-            }
+            nexusflow::Config config = parseModuleConfig(module_item);
 
             auto node = std::make_shared<NodeWithModuleClassName>(nodeName, moduleClassName, std::move(config));
 
@@ -170,8 +185,17 @@ std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath) {
                     return nullptr;
                 }
 
+                // parse the optional edge filter.
+                nexusflow::Config edgeConfig;
+                const YAML::Node& filterNode = connection_item["filter"];
+                if (filterNode && filterNode.IsMap()) {
+                    for (const auto& kv : filterNode) {
+                        edgeConfig.Add(kv.first.as<std::string>(), convertYamlNodeToAny(kv.second));
+                    }
+                }
+
                 // 假设 addEdge 会将节点添加到 Graph 的内部 m_nodeMap 中
-                graph->addEdge(srcIt->second, dstIt->second);
+                graph->addEdge(srcIt->second, dstIt->second, edgeConfig);
                 outDegree[fromName]++;
                 inDegree[toName]++;
             }
@@ -226,4 +250,27 @@ std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath) {
     }
 }
 
-} // namespace graphutils
\ No newline at end of file
+bool ParseModuleConfigsFromYaml(const std::string& yamlText, std::unordered_map<std::string, ModuleConfigEntry>& moduleConfigs) {
+    moduleConfigs.clear();
+    try {
+        YAML::Node root = YAML::Load(yamlText);
+        const YAML::Node& modules_yaml = root["graph"]["modules"];
+        if (!modules_yaml || !modules_yaml.IsSequence()) {
+            LOG_ERROR("'modules' section is missing or not a sequence.");
+            return false;
+        }
+        for (const auto& module_item : modules_yaml) {
+            ModuleConfigEntry entry;
+            const YAML::Node& configsNode = module_item["config"];
+            entry.yamlText = configsNode ? YAML::Dump(configsNode) : std::string();
+            entry.config = parseModuleConfig(module_item);
+            moduleConfigs[module_item["name"].as<std::string>()] = std::move(entry);
+        }
+        return true;
+    } catch (const YAML::Exception& e) {
+        LOG_ERROR("Failed to parse module configs due to a parsing error: {}", e.what());
+        return false;
+    }
+}
+
+} // namespace graphutils
@@ -2,9 +2,22 @@
 #pragma once
 
 #include "base/Graph.hpp"
+#include "nexusflow/Config.hpp"
+
+#include <string>
+#include <unordered_map>
 
 namespace graphutils {
 
 std::unique_ptr<Graph> CreateGraphFromYaml(const std::string& configPath);
 
+// The `config` section of a module in a YAML graph, with its YAML text to tell whether it changed.
+struct ModuleConfigEntry {
+    std::string yamlText;
+    nexusflow::Config config;
+};
+
+// Parses the `config` section of every module of a YAML graph text, by module name. Returns false on a parsing error.
+bool ParseModuleConfigsFromYaml(const std::string& yamlText, std::unordered_map<std::string, ModuleConfigEntry>& moduleConfigs);
+
 }
@@ -222,3 +222,57 @@ TEST(TestGraph, TestToString) {
     ASSERT_NE(repr.find("b"), std::string::npos);
     ASSERT_NE(repr.find("c"), std::string::npos);
 }
+
+TEST(TestGraph, TestTopologicalLevels) {
+    // a -> b -> d, a -> c -> d, b -> e, f -> e
+    {
+        Graph graph;
+
+        graph.addEdge(a, b);
+        graph.addEdge(a, c);
+        graph.addEdge(b, d);
+        graph.addEdge(c, d);
+        graph.addEdge(b, e);
+        graph.addEdge(f, e);
+
+        std::vector<std::vector<std::string>> expected{{"a", "f"}, {"b", "c"}, {"d", "e"}};
+        ASSERT_EQ(graph.toTopologicalLevels(), expected);
+    }
+
+    // a -> b -> a, 有环.
+    {
+        Graph graph;
+
+        graph.addEdge(a, b);
+        graph.addEdge(b, a);
+
+        ASSERT_TRUE(graph.toTopologicalLevels().empty());
+    }
+}
+
+TEST(TestGraph, TestRemoveNodeAndEdge) {
+    // a -> b -> c, a -> c, d alone
+    Graph graph;
+
+    graph.addEdge(a, b);
+    graph.addEdge(b, c);
+    nexusflow::Config edgeConfig;
+    edgeConfig.Add("sampleEveryN", 2);
+    graph.addEdge(a, c, edgeConfig);
+    graph.addNode(d);
+
+    std::vector<std::vector<std::string>> expected{{"a", "d"}, {"b"}, {"c"}};
+    ASSERT_EQ(graph.toTopologicalLevels(), expected);
+    ASSERT_EQ(graph.getEdgeConfig("a", "c").GetValueOrDefault<int>("sampleEveryN", 0), 2);
+
+    ASSERT_TRUE(graph.removeEdge("a", "c"));
+    ASSERT_FALSE(graph.removeEdge("a", "c"));
+    ASSERT_FALSE(graph.hasEdge("a", "c"));
+    ASSERT_TRUE(graph.getEdgeConfig("a", "c").GetConfigMap().empty());
+
+    ASSERT_TRUE(graph.removeNode("b"));
+    ASSERT_FALSE(graph.removeNode("b"));
+    ASSERT_EQ(graph.findNode("b"), nullptr);
+    expected = {{"a", "c", "d"}};
+    ASSERT_EQ(graph.toTopologicalLevels(), expected);
+}
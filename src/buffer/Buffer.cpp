@@ -0,0 +1,53 @@
+#include "nexusflow/Buffer.hpp"
+#include "MemoryUtils.hpp"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace nexusflow {
+
+Buffer Buffer::Allocate(size_t size, size_t alignment) {
+    if (!memory::IsPowerOfTwo(alignment)) {
+        throw std::invalid_argument("Buffer alignment must be a power of two, alignment=" + std::to_string(alignment));
+    }
+    if (size == 0) {
+        return {};
+    }
+
+    auto* slab = static_cast<uint8_t*>(memory::AlignedAlloc(size, alignment));
+    if (slab == nullptr) {
+        throw std::bad_alloc();
+    }
+    return Buffer(std::shared_ptr<uint8_t>(slab, [](uint8_t* ptr) { memory::AlignedFree(ptr); }), size);
+}
+
+Buffer Buffer::CopyFrom(const void* data, size_t size, size_t alignment) {
+    Buffer buffer = Allocate(size, alignment);
+    if (size > 0) {
+        std::memcpy(buffer.m_data, data, size);
+    }
+    return buffer;
+}
+
+uint8_t* Buffer::MutableData() noexcept {
+    if (m_data == nullptr || m_storage.use_count() > 1) {
+        return nullptr;
+    }
+    return m_data;
+}
+
+Buffer Buffer::Slice(size_t offset, size_t length) const {
+    if (offset > m_size || length > m_size - offset) {
+        throw std::out_of_range("Buffer slice out of range, offset=" + std::to_string(offset) +
+                                ", length=" + std::to_string(length) + ", size=" + std::to_string(m_size));
+    }
+
+    Buffer view;
+    view.m_storage = m_storage;
+    view.m_data = m_data + offset;
+    view.m_size = length;
+    return view;
+}
+
+} // namespace nexusflow
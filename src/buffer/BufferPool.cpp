@@ -0,0 +1,155 @@
+#include "nexusflow/BufferPool.hpp"
+#include "MemoryUtils.hpp"
+#include "utils/logging.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace nexusflow {
+
+// --- BufferPool's Private Implementation (m_pImpl) ---
+// Owned jointly by the BufferPool and by every outstanding Buffer, so that a buffer
+// released after the pool was destroyed can still be recycled into valid memory.
+class BufferPool::Impl {
+public:
+    explicit Impl(const BufferPoolOptions& options)
+        : options(options), stride(memory::AlignUp(options.bufferSize, options.alignment)) {}
+
+    ~Impl() {
+        for (auto& chunk : chunks) {
+            if (chunk.isMapped) {
+                memory::UnmapPages(chunk.ptr, chunk.size);
+            } else {
+                memory::AlignedFree(chunk.ptr);
+            }
+        }
+    }
+
+    uint8_t* Take() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeList.empty() && !Grow(totalCount == 0 ? options.initialCount : totalCount)) {
+            return nullptr;
+        }
+        uint8_t* slab = freeList.back();
+        freeList.pop_back();
+        return slab;
+    }
+
+    void Recycle(uint8_t* slab) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeList.push_back(slab);
+    }
+
+    // Allocates one chunk holding at least `count` more slabs, must be called while holding the lock.
+    bool Grow(size_t count) {
+        count = std::max<size_t>(count, 1);
+        if (options.maxCount > 0) {
+            if (totalCount >= options.maxCount) {
+                LOG_WARN("BufferPool exhausted, maxCount={}", options.maxCount);
+                return false;
+            }
+            count = std::min(count, options.maxCount - totalCount);
+        }
+
+        Chunk chunk;
+        size_t slabCount = count;
+
+        // Page mappings are required for huge pages and NUMA binding, they are page aligned.
+        const bool needMapping = options.useHugePages || options.numaNode >= 0;
+        if (needMapping && options.alignment <= memory::GetPageSize()) {
+            size_t granularity = options.useHugePages ? memory::GetHugePageSize() : memory::GetPageSize();
+            chunk.size = memory::AlignUp(stride * count, granularity);
+            chunk.ptr = memory::MapPages(chunk.size, options.useHugePages, options.numaNode);
+            chunk.isMapped = chunk.ptr != nullptr;
+            if (chunk.isMapped) {
+                // Use the rounding slack of the mapping for extra slabs, within the limit.
+                slabCount = chunk.size / stride;
+                if (options.maxCount > 0) slabCount = std::min(slabCount, options.maxCount - totalCount);
+            }
+        }
+
+        if (!chunk.isMapped) {
+            chunk.size = stride * count;
+            chunk.ptr = memory::AlignedAlloc(chunk.size, options.alignment);
+            if (chunk.ptr == nullptr) {
+                LOG_ERROR("BufferPool failed to allocate {} bytes", chunk.size);
+                return false;
+            }
+        }
+
+        auto* base = static_cast<uint8_t*>(chunk.ptr);
+        freeList.reserve(freeList.size() + slabCount);
+        for (size_t idx = 0; idx < slabCount; ++idx) {
+            freeList.push_back(base + idx * stride);
+        }
+        chunks.push_back(chunk);
+        totalCount += slabCount;
+
+        LOG_DEBUG("BufferPool grew by {} buffers, bufferSize={}, totalCount={}, hugePages={}, mapped={}", slabCount,
+                  options.bufferSize, totalCount, options.useHugePages, chunk.isMapped);
+        return true;
+    }
+
+    struct Chunk {
+        void* ptr = nullptr;
+        size_t size = 0;
+        bool isMapped = false;
+    };
+
+    const BufferPoolOptions options;
+    const size_t stride; // Distance between two slabs, keeps every slab aligned.
+
+    mutable std::mutex mutex;
+    std::vector<uint8_t*> freeList;
+    std::vector<Chunk> chunks;
+    size_t totalCount = 0;
+};
+
+// --- BufferPool's Public Methods ---
+
+std::shared_ptr<BufferPool> BufferPool::Create(const BufferPoolOptions& options) {
+    if (options.bufferSize == 0) {
+        LOG_ERROR("BufferPool bufferSize must be greater than 0");
+        return nullptr;
+    }
+    if (!memory::IsPowerOfTwo(options.alignment)) {
+        LOG_ERROR("BufferPool alignment must be a power of two, alignment={}", options.alignment);
+        return nullptr;
+    }
+    return std::shared_ptr<BufferPool>(new BufferPool(options));
+}
+
+BufferPool::BufferPool(const BufferPoolOptions& options) : m_pImpl(std::make_shared<Impl>(options)) {
+    if (options.initialCount > 0) {
+        std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+        m_pImpl->Grow(options.initialCount);
+    }
+}
+
+BufferPool::~BufferPool() = default;
+
+Buffer BufferPool::Acquire() {
+    uint8_t* slab = m_pImpl->Take();
+    if (slab == nullptr) {
+        return {};
+    }
+
+    // The deleter keeps the memory alive and hands the slab back once the last view is gone.
+    std::shared_ptr<Impl> impl = m_pImpl;
+    return Buffer(std::shared_ptr<uint8_t>(slab, [impl](uint8_t* ptr) { impl->Recycle(ptr); }), impl->options.bufferSize);
+}
+
+size_t BufferPool::GetBufferSize() const { return m_pImpl->options.bufferSize; }
+
+size_t BufferPool::GetIdleCount() const {
+    std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+    return m_pImpl->freeList.size();
+}
+
+size_t BufferPool::GetTotalCount() const {
+    std::lock_guard<std::mutex> lock(m_pImpl->mutex);
+    return m_pImpl->totalCount;
+}
+
+} // namespace nexusflow
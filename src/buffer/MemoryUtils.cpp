@@ -0,0 +1,119 @@
+#include "MemoryUtils.hpp"
+#include "utils/logging.hpp"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nexusflow { namespace memory {
+
+namespace {
+
+constexpr size_t kDefaultPageSize = 4096;
+constexpr size_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+#if defined(__linux__) && defined(SYS_mbind)
+// Mirrors MPOL_BIND from <numaif.h>, which is only available together with libnuma.
+constexpr int kMemPolicyBind = 2;
+
+bool BindToNumaNode(void* ptr, size_t size, int numaNode) {
+    constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;
+    if (numaNode < 0 || static_cast<size_t>(numaNode) >= kBitsPerWord) {
+        return false;
+    }
+    unsigned long nodeMask = 1UL << numaNode;
+    return syscall(SYS_mbind, ptr, size, kMemPolicyBind, &nodeMask, kBitsPerWord, 0) == 0;
+}
+#endif
+
+} // namespace
+
+void* AlignedAlloc(size_t size, size_t alignment) {
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+#if defined(_MSC_VER)
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+void AlignedFree(void* ptr) {
+#if defined(_MSC_VER)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+size_t GetPageSize() {
+#if defined(__linux__)
+    long pageSize = sysconf(_SC_PAGESIZE);
+    return pageSize > 0 ? static_cast<size_t>(pageSize) : kDefaultPageSize;
+#else
+    return kDefaultPageSize;
+#endif
+}
+
+size_t GetHugePageSize() { return kDefaultHugePageSize; }
+
+void* MapPages(size_t size, bool useHugePages, int numaNode) {
+#if defined(__linux__)
+    void* ptr = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+    // 1. Explicit huge pages, only available if the administrator reserved some.
+    if (useHugePages && size % GetHugePageSize() == 0) {
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED) {
+            LOG_DEBUG("mmap with MAP_HUGETLB failed, falling back to transparent huge pages, size={}", size);
+        }
+    }
+#endif
+
+    // 2. Regular pages, optionally promoted to transparent huge pages by the kernel.
+    if (ptr == MAP_FAILED) {
+        ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            LOG_ERROR("mmap failed, size={}", size);
+            return nullptr;
+        }
+#if defined(MADV_HUGEPAGE)
+        if (useHugePages) {
+            madvise(ptr, size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+#if defined(SYS_mbind)
+    // The policy must be set before the first touch, which decides the physical placement.
+    if (numaNode >= 0 && !BindToNumaNode(ptr, size, numaNode)) {
+        LOG_WARN("Failed to bind memory to NUMA node {}, size={}", numaNode, size);
+    }
+#endif
+    return ptr;
+#else
+    (void)size;
+    (void)useHugePages;
+    (void)numaNode;
+    return nullptr;
+#endif
+}
+
+void UnmapPages(void* ptr, size_t size) {
+#if defined(__linux__)
+    if (ptr != nullptr) munmap(ptr, size);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+}} // namespace nexusflow::memory
@@ -0,0 +1,34 @@
+#ifndef NEXUSFLOW_BUFFER_MEMORY_UTILS_HPP
+#define NEXUSFLOW_BUFFER_MEMORY_UTILS_HPP
+
+#include <cstddef>
+
+namespace nexusflow { namespace memory {
+
+// Rounds `value` up to the next multiple of `alignment`, which must be a power of two.
+inline size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+inline bool IsPowerOfTwo(size_t value) { return value != 0 && (value & (value - 1)) == 0; }
+
+// Heap allocation with an explicit alignment, returns nullptr on failure.
+void* AlignedAlloc(size_t size, size_t alignment);
+void AlignedFree(void* ptr);
+
+// Size of a regular and of a huge memory page on this platform.
+size_t GetPageSize();
+size_t GetHugePageSize();
+
+/**
+ * @brief Maps `size` bytes of anonymous memory directly from the OS.
+ * @param size The size of the mapping, rounded up to the page size by the caller.
+ * @param useHugePages Try explicit huge pages first, then transparent huge pages.
+ * @param numaNode Bind the mapping to this NUMA node, -1 means no binding.
+ * @return The page-aligned mapping, or nullptr if the platform does not support
+ *         anonymous mappings or the mapping failed.
+ */
+void* MapPages(size_t size, bool useHugePages, int numaNode);
+void UnmapPages(void* ptr, size_t size);
+
+}} // namespace nexusflow::memory
+
+#endif // NEXUSFLOW_BUFFER_MEMORY_UTILS_HPP
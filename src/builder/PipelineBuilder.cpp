@@ -19,6 +19,7 @@ class PipelineBuilder::Impl {
 public:
     std::vector<std::shared_ptr<Module>> modules;
     std::vector<std::pair<std::string, std::string>> connections;
+    std::vector<Config> connectionConfigs; // Parallel to `connections`.
 };
 
 // --- PipelineBuilder's Public Methods ---
@@ -40,8 +41,14 @@ PipelineBuilder& PipelineBuilder::AddModule(const std::shared_ptr<Module>& modul
 }
 
 PipelineBuilder& PipelineBuilder::Connect(const std::string& srcModuleName, const std::string& dstModuleName) {
+    return Connect(srcModuleName, dstModuleName, Config());
+}
+
+PipelineBuilder& PipelineBuilder::Connect(const std::string& srcModuleName, const std::string& dstModuleName,
+                                          const Config& edgeConfig) {
     if (m_pImpl && !srcModuleName.empty() && !dstModuleName.empty()) {
         m_pImpl->connections.emplace_back(srcModuleName, dstModuleName);
+        m_pImpl->connectionConfigs.push_back(edgeConfig);
     }
     return *this;
 }
@@ -79,7 +86,8 @@ std::unique_ptr<Pipeline> PipelineBuilder::Build() {
     // Keep track of which nodes have incoming edges.
     std::unordered_set<std::string> nodesWithIncomingEdges;
 
-    for (const auto& conn : m_pImpl->connections) {
+    for (size_t connIdx = 0; connIdx < m_pImpl->connections.size(); ++connIdx) {
+        const auto& conn = m_pImpl->connections[connIdx];
         const std::string& fromName = conn.first;
         const std::string& toName = conn.second;
 
@@ -91,7 +99,7 @@ std::unique_ptr<Pipeline> PipelineBuilder::Build() {
             return nullptr;
         }
 
-        graph->addEdge(fromIt->second, toIt->second);
+        graph->addEdge(fromIt->second, toIt->second, m_pImpl->connectionConfigs[connIdx]);
         nodesWithIncomingEdges.insert(toName);
     }
 
@@ -1,6 +1,7 @@
 #ifndef CONCURRENT_QUEUE_HPP_
 #define CONCURRENT_QUEUE_HPP_
 
+#include "InboxSignal.hpp"
 #include "Optional.hpp"
 #include <condition_variable>
 #include <cstddef>
@@ -50,6 +51,7 @@ public:
 
         m_queue.push(std::move(item));
         m_condNotEmpty.notify_one();
+        notifySignal();
         return true;
     }
 
@@ -77,6 +79,7 @@ public:
         if (m_shutdown) return false;
         m_queue.push(std::move(item));
         m_condNotEmpty.notify_one();
+        notifySignal();
         return true;
     }
 
@@ -100,6 +103,7 @@ public:
 
         m_queue.push(std::move(item));
         m_condNotEmpty.notify_one();
+        notifySignal();
         return true;
     }
 
@@ -184,6 +188,12 @@ public:
         return true;
     }
 
+    /**
+     * @brief Sets a signal notified after every push, for consumers waiting on several queues.
+     * Must be set before producers start pushing.
+     */
+    void setSignal(InboxSignal* signal) { m_signal = signal; }
+
     /**
      * @brief Shuts down the queue.
      * This will wake up all waiting producer and consumer threads.
@@ -193,6 +203,7 @@ public:
         m_shutdown = true;
         m_condNotEmpty.notify_all();
         m_condNotFull.notify_all();
+        notifySignal();
     }
 
     /**
@@ -212,6 +223,12 @@ public:
     }
 
 private:
+    void notifySignal() {
+        if (m_signal != nullptr) {
+            m_signal->notify();
+        }
+    }
+
     /**
      * @brief Checks if the queue is full. Must be called while holding the lock.
      */
@@ -228,6 +245,7 @@ private:
     std::condition_variable m_condNotFull;
     std::queue<T> m_queue;
     const int m_capacity;
+    InboxSignal* m_signal = nullptr;
     bool m_shutdown;
 };
 
@@ -0,0 +1,77 @@
+#ifndef EPOCH_DOMAIN_HPP_
+#define EPOCH_DOMAIN_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+/**
+ * @class EpochDomain
+ * @brief Epoch-based reclamation for data that is read on a hot path and replaced rarely.
+ *
+ * Readers bracket every access with a `Guard`, which counts them in the current epoch. A writer
+ * publishes a new version of the data, calls `synchronize()`, and may then free the old version:
+ *
+ *     auto guard = domain.enter();
+ *     const Data* data = current.load();   // Valid until the guard is destroyed.
+ *
+ *     const Data* old = current.exchange(newData);
+ *     domain.synchronize();                // No reader sees `old` anymore.
+ *     delete old;
+ *
+ * `synchronize()` advances the epoch twice and each time waits for the readers of the epoch it
+ * left, so a reader that loaded a stale epoch is waited for too. Entering and leaving cost one
+ * atomic increment and decrement; writers never block readers, and must be serialized.
+ */
+class EpochDomain {
+public:
+    class Guard {
+    public:
+        Guard(Guard&& other) noexcept : m_readerCount(other.m_readerCount) { other.m_readerCount = nullptr; }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard& operator=(Guard&&) = delete;
+
+        ~Guard() {
+            if (m_readerCount != nullptr) {
+                m_readerCount->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+    private:
+        friend class EpochDomain;
+
+        explicit Guard(std::atomic<size_t>* readerCount) : m_readerCount(readerCount) {}
+
+        std::atomic<size_t>* m_readerCount;
+    };
+
+    EpochDomain() = default;
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    Guard enter() {
+        auto* readerCount = &m_readerCounts[m_epoch.load(std::memory_order_relaxed) & 1];
+        // Sequentially consistent, so the data is loaded after the writer either waits for this reader or published.
+        readerCount->fetch_add(1, std::memory_order_seq_cst);
+        return Guard(readerCount);
+    }
+
+    // Waits until every reader that entered before the call has left.
+    void synchronize() {
+        for (int phase = 0; phase < 2; ++phase) {
+            const size_t previousEpoch = m_epoch.fetch_add(1, std::memory_order_seq_cst);
+            while (m_readerCounts[previousEpoch & 1].load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    std::atomic<size_t> m_epoch{0};
+    std::atomic<size_t> m_readerCounts[2] = {{0}, {0}}; // By epoch parity.
+};
+
+#endif // EPOCH_DOMAIN_HPP_
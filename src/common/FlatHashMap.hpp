@@ -0,0 +1,166 @@
+#ifndef FLAT_HASH_MAP_HPP_
+#define FLAT_HASH_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @class FlatHashMap
+ * @brief An open-addressing hash map from 64-bit keys to values, stored in one flat array.
+ *
+ * Lookups probe linearly through contiguous slots instead of chasing per-node pointers as
+ * `std::unordered_map` does, and erasing shifts the following entries back instead of
+ * leaving tombstones, so the table never degrades under churn. The table doubles when it
+ * is 7/8 full.
+ *
+ * Pointers returned by `find()` and `emplace()` are invalidated by any later insertion or
+ * erasure.
+ *
+ * @tparam V The type of the values, must be default-constructible and movable.
+ */
+template <typename V>
+class FlatHashMap {
+public:
+    explicit FlatHashMap(size_t initialCapacity = 16) { rehash(initialCapacity); }
+
+    /**
+     * @brief Finds the value of a key.
+     * @return A pointer to the value, or nullptr if the key is absent.
+     */
+    V* find(uint64_t key) {
+        size_t index = indexOf(key);
+        for (;; index = (index + 1) & m_mask) {
+            Slot& slot = m_slots[index];
+            if (!slot.occupied) {
+                return nullptr;
+            }
+            if (slot.key == key) {
+                return &slot.value;
+            }
+        }
+    }
+
+    const V* find(uint64_t key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    /**
+     * @brief Gets the value of a key, inserting a default-constructed value if the key is absent.
+     * @param inserted Set to true if the key was inserted.
+     */
+    V& emplace(uint64_t key, bool& inserted) {
+        if ((m_size + 1) * 8 > m_slots.size() * 7) {
+            rehash(m_slots.size() * 2);
+        }
+
+        size_t index = indexOf(key);
+        for (;; index = (index + 1) & m_mask) {
+            Slot& slot = m_slots[index];
+            if (!slot.occupied) {
+                slot.occupied = true;
+                slot.key = key;
+                slot.value = V();
+                ++m_size;
+                inserted = true;
+                return slot.value;
+            }
+            if (slot.key == key) {
+                inserted = false;
+                return slot.value;
+            }
+        }
+    }
+
+    /**
+     * @brief Removes a key.
+     * @return true if the key was present.
+     */
+    bool erase(uint64_t key) {
+        size_t index = indexOf(key);
+        for (;; index = (index + 1) & m_mask) {
+            if (!m_slots[index].occupied) {
+                return false;
+            }
+            if (m_slots[index].key == key) {
+                break;
+            }
+        }
+
+        // Backward-shift deletion: move later entries of the probe chain into the hole.
+        size_t hole = index;
+        for (size_t next = (hole + 1) & m_mask; m_slots[next].occupied; next = (next + 1) & m_mask) {
+            size_t home = indexOf(m_slots[next].key);
+            // The entry may fill the hole only if its home slot is not inside (hole, next].
+            bool homeInRange = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+            if (!homeInRange) {
+                m_slots[hole] = std::move(m_slots[next]);
+                hole = next;
+            }
+        }
+        m_slots[hole].occupied = false;
+        m_slots[hole].value = V(); // Release what the value holds right away.
+        --m_size;
+        return true;
+    }
+
+    void clear() {
+        for (auto& slot : m_slots) {
+            slot.occupied = false;
+            slot.value = V();
+        }
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+
+    bool empty() const { return m_size == 0; }
+
+    // Calls `func(key, value)` for every entry, in no particular order.
+    template <typename Func>
+    void forEach(Func&& func) {
+        for (auto& slot : m_slots) {
+            if (slot.occupied) {
+                func(slot.key, slot.value);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        bool occupied = false;
+        V value;
+    };
+
+    // The splitmix64 finalizer, ids are often sequential.
+    size_t indexOf(uint64_t key) const {
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<size_t>(key ^ (key >> 31)) & m_mask;
+    }
+
+    void rehash(size_t capacity) {
+        size_t slotCount = 16;
+        while (slotCount < capacity) {
+            slotCount <<= 1;
+        }
+
+        std::vector<Slot> oldSlots(slotCount);
+        oldSlots.swap(m_slots);
+        m_mask = slotCount - 1;
+        m_size = 0;
+
+        for (auto& slot : oldSlots) {
+            if (slot.occupied) {
+                bool inserted = false;
+                emplace(slot.key, inserted) = std::move(slot.value);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+    size_t m_size = 0;
+};
+
+#endif // FLAT_HASH_MAP_HPP_
@@ -0,0 +1,69 @@
+#ifndef INBOX_SIGNAL_HPP_
+#define INBOX_SIGNAL_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @class InboxSignal
+ * @brief Wakes up a consumer that reads from several queues when any of them receives an item.
+ *
+ * Producers call `notify()` after every push; it bumps a sequence number and only touches
+ * the mutex when the consumer is actually asleep. The consumer remembers the sequence
+ * before draining its inputs and, if they were all empty, waits for the sequence to move:
+ *
+ *     uint64_t seen = signal.sequence();
+ *     ... drain all inputs with tryPop ...
+ *     if (nothing was popped) signal.wait(seen);
+ *
+ * A push racing with the drain changes the sequence, so no wake-up is ever lost.
+ */
+class InboxSignal {
+public:
+    InboxSignal() = default;
+
+    InboxSignal(const InboxSignal&) = delete;
+    InboxSignal& operator=(const InboxSignal&) = delete;
+
+    void notify() {
+        m_sequence.fetch_add(1, std::memory_order_seq_cst);
+        if (m_waiterCount.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cond.notify_all();
+        }
+    }
+
+    uint64_t sequence() const { return m_sequence.load(std::memory_order_seq_cst); }
+
+    // Waits until the sequence differs from `seenSequence`.
+    void wait(uint64_t seenSequence) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+        m_cond.wait(lock, [this, seenSequence] { return sequence() != seenSequence; });
+        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Waits until the sequence differs from `seenSequence`, or the timeout elapses.
+     * @return true if notified, false on timeout.
+     */
+    template <class Rep, class Per>
+    bool waitFor(uint64_t seenSequence, const std::chrono::duration<Rep, Per>& timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+        bool notified = m_cond.wait_for(lock, timeout, [this, seenSequence] { return sequence() != seenSequence; });
+        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+        return notified;
+    }
+
+private:
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<int> m_waiterCount{0};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+#endif // INBOX_SIGNAL_HPP_
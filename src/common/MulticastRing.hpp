@@ -0,0 +1,219 @@
+#ifndef MULTICAST_RING_HPP_
+#define MULTICAST_RING_HPP_
+
+#include "InboxSignal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class MulticastRing
+ * @brief A preallocated single-producer, multi-consumer broadcast ring (Disruptor style).
+ *
+ * The producer writes every item once into the next slot; each consumer advances its own
+ * sequence cursor over the same slots. Publishing therefore costs the same no matter how
+ * many consumers read the ring, compared to one lock and one copy per consumer with
+ * separate queues.
+ *
+ * A slot can be overwritten once the slowest cursor has passed it. The producer only scans
+ * the cursors when it is about to wrap onto a slot it has not seen released yet, and it
+ * then also clears the released slots, so items do not outlive their last reader by more
+ * than one lap of the ring.
+ *
+ * Consumers must be added before the producer starts publishing. `tryPublish` must only be
+ * called from one thread at a time; every consumer must only be read from one thread.
+ *
+ * @tparam T The type of elements stored in the ring, must be default-constructible and copyable.
+ */
+template <typename T>
+class MulticastRing {
+public:
+    class Reader;
+
+    /**
+     * @brief Constructs a MulticastRing.
+     * @param capacity The number of slots, rounded up to a power of two.
+     */
+    explicit MulticastRing(size_t capacity) {
+        size_t slotCount = 1;
+        while (slotCount < capacity) {
+            slotCount <<= 1;
+        }
+        m_slots.resize(slotCount);
+        m_mask = slotCount - 1;
+    }
+
+    // Disable copy and move semantics, readers point into the ring.
+    MulticastRing(const MulticastRing&) = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    /**
+     * @brief Registers a new consumer. It will see every item published from now on.
+     * @param signal An optional signal notified on every publish, for consumers waiting on several inputs.
+     * @return The reader for the new consumer.
+     */
+    Reader addConsumer(InboxSignal* signal = nullptr) {
+        if (signal != nullptr) {
+            m_signals.push_back(signal);
+        }
+        auto cursor = std::make_unique<Cursor>();
+        cursor->sequence.store(m_publishedSequence.load(std::memory_order_acquire), std::memory_order_relaxed);
+        m_cursors.push_back(std::move(cursor));
+        return Reader(this, m_cursors.back().get());
+    }
+
+    /**
+     * @brief Publishes an item to all consumers without blocking.
+     * @return true if published, false if the slowest consumer is a full ring behind or the ring is shut down.
+     */
+    bool tryPublish(const T& item) {
+        if (m_shutdown.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        const uint64_t sequence = m_publishedSequence.load(std::memory_order_relaxed);
+        if (sequence - m_releasedSequence >= m_slots.size()) {
+            reclaimSlots();
+            if (sequence - m_releasedSequence >= m_slots.size()) {
+                return false; // The slowest consumer has not released the slot yet.
+            }
+        }
+
+        m_slots[sequence & m_mask] = item;
+        m_publishedSequence.store(sequence + 1, std::memory_order_seq_cst);
+
+        if (m_waiterCount.load(std::memory_order_seq_cst) > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_condPublished.notify_all();
+        }
+        for (auto* signal : m_signals) {
+            signal->notify();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Shuts down the ring, waking up all waiting consumers.
+     */
+    void shutdown() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+        m_condPublished.notify_all();
+    }
+
+    size_t getCapacity() const { return m_slots.size(); }
+
+    size_t getConsumerCount() const { return m_cursors.size(); }
+
+private:
+    // Each cursor sits on its own cache line, consumers do not invalidate each other.
+    struct Cursor {
+        std::atomic<uint64_t> sequence{0};
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    // Moves the released sequence up to the slowest cursor and clears the released slots.
+    void reclaimSlots() {
+        uint64_t slowest = m_publishedSequence.load(std::memory_order_relaxed);
+        for (const auto& cursor : m_cursors) {
+            uint64_t sequence = cursor->sequence.load(std::memory_order_acquire);
+            if (sequence < slowest) {
+                slowest = sequence;
+            }
+        }
+        for (; m_releasedSequence < slowest; ++m_releasedSequence) {
+            m_slots[m_releasedSequence & m_mask] = T();
+        }
+    }
+
+    bool tryRead(Cursor* cursor, T& itemRef) {
+        const uint64_t sequence = cursor->sequence.load(std::memory_order_relaxed);
+        if (sequence >= m_publishedSequence.load(std::memory_order_acquire)) {
+            return false;
+        }
+        itemRef = m_slots[sequence & m_mask];
+        cursor->sequence.store(sequence + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <class Rep, class Per>
+    bool waitAndReadFor(Cursor* cursor, T& itemRef, const std::chrono::duration<Rep, Per>& timeout) {
+        if (tryRead(cursor, itemRef)) {
+            return true;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+        bool published = m_condPublished.wait_for(lock, timeout, [this, cursor] {
+            return m_shutdown || cursor->sequence.load(std::memory_order_relaxed) <
+                                     m_publishedSequence.load(std::memory_order_seq_cst);
+        });
+        m_waiterCount.fetch_sub(1, std::memory_order_relaxed);
+        lock.unlock();
+
+        return published && tryRead(cursor, itemRef);
+    }
+
+    size_t pendingCount(const Cursor* cursor) const {
+        return static_cast<size_t>(m_publishedSequence.load(std::memory_order_acquire) -
+                                   cursor->sequence.load(std::memory_order_relaxed));
+    }
+
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+
+    std::atomic<uint64_t> m_publishedSequence{0}; // The sequence of the next slot to write.
+    uint64_t m_releasedSequence = 0; // Producer only, every slot before it is released.
+    std::vector<std::unique_ptr<Cursor>> m_cursors;
+    std::vector<InboxSignal*> m_signals;
+
+    // Sleeping consumers, the producer only takes the mutex when someone waits.
+    std::mutex m_mutex;
+    std::condition_variable m_condPublished;
+    std::atomic<int> m_waiterCount{0};
+    std::atomic<bool> m_shutdown{false};
+};
+
+/**
+ * @class MulticastRing::Reader
+ * @brief One consumer's view of a MulticastRing, with the pop interface of ConcurrentQueue.
+ */
+template <typename T>
+class MulticastRing<T>::Reader {
+public:
+    Reader() = default;
+
+    /**
+     * @brief Reads the next item without blocking.
+     * @return true if an item was read, false if the consumer is caught up.
+     */
+    bool tryPop(T& itemRef) { return m_ring->tryRead(m_cursor, itemRef); }
+
+    /**
+     * @brief Reads the next item, waiting up to a specified timeout.
+     * @return true if an item was read, false if timed out or shutdown.
+     */
+    template <class Rep, class Per>
+    bool waitAndPopFor(T& itemRef, const std::chrono::duration<Rep, Per>& timeout) {
+        return m_ring->waitAndReadFor(m_cursor, itemRef, timeout);
+    }
+
+    // The number of published items this consumer has not read yet.
+    size_t getSize() const { return m_ring->pendingCount(m_cursor); }
+
+private:
+    friend class MulticastRing<T>;
+
+    Reader(MulticastRing<T>* ring, Cursor* cursor) : m_ring(ring), m_cursor(cursor) {}
+
+    MulticastRing<T>* m_ring = nullptr;
+    Cursor* m_cursor = nullptr;
+};
+
+#endif // MULTICAST_RING_HPP_
@@ -0,0 +1,48 @@
+#include "../FlatHashMap.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+TEST(FlatHashMapTest, InsertFindErase) {
+    FlatHashMap<std::string> map;
+    bool inserted = false;
+    map.emplace(7, inserted) = "seven";
+    EXPECT_TRUE(inserted);
+    map.emplace(7, inserted);
+    EXPECT_FALSE(inserted);
+
+    ASSERT_NE(map.find(7), nullptr);
+    EXPECT_EQ(*map.find(7), "seven");
+    EXPECT_EQ(map.find(8), nullptr);
+
+    EXPECT_TRUE(map.erase(7));
+    EXPECT_FALSE(map.erase(7));
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMapUnderChurn) {
+    FlatHashMap<uint64_t> map(4);
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 rng(42);
+
+    for (int step = 0; step < 20000; ++step) {
+        uint64_t key = rng() % 512; // Small key space, many collisions and erasures.
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+        } else {
+            bool inserted = false;
+            map.emplace(key, inserted) = step;
+            EXPECT_EQ(inserted, reference.find(key) == reference.end());
+            reference[key] = step;
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    for (const auto& pair : reference) {
+        const uint64_t* value = map.find(pair.first);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, pair.second);
+    }
+}
@@ -0,0 +1,91 @@
+#include "../MulticastRing.hpp"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(MulticastRingTest, EveryConsumerSeesEveryItem) {
+    MulticastRing<int> ring(3);
+    EXPECT_EQ(ring.getCapacity(), 4u);
+
+    auto first = ring.addConsumer();
+    auto second = ring.addConsumer();
+    for (int idx = 0; idx < 4; ++idx) {
+        ASSERT_TRUE(ring.tryPublish(idx));
+    }
+    // The ring is full until the slowest consumer releases a slot.
+    EXPECT_FALSE(ring.tryPublish(4));
+
+    int value = -1;
+    for (int idx = 0; idx < 4; ++idx) {
+        ASSERT_TRUE(first.tryPop(value));
+        EXPECT_EQ(value, idx);
+    }
+    EXPECT_FALSE(first.tryPop(value));
+    EXPECT_FALSE(ring.tryPublish(4));
+
+    ASSERT_TRUE(second.tryPop(value));
+    EXPECT_EQ(second.getSize(), 3u);
+    EXPECT_TRUE(ring.tryPublish(4));
+    ASSERT_TRUE(first.tryPop(value));
+    EXPECT_EQ(value, 4);
+}
+
+TEST(MulticastRingTest, ReleasedSlotsAreCleared) {
+    MulticastRing<std::shared_ptr<int>> ring(2);
+    auto reader = ring.addConsumer();
+
+    auto payload = std::make_shared<int>(7);
+    ASSERT_TRUE(ring.tryPublish(payload));
+    ASSERT_TRUE(ring.tryPublish(std::make_shared<int>(8)));
+    EXPECT_EQ(payload.use_count(), 2);
+
+    std::shared_ptr<int> value;
+    ASSERT_TRUE(reader.tryPop(value));
+    value.reset();
+    // Wrapping onto the released slot clears it.
+    ASSERT_TRUE(ring.tryPublish(std::make_shared<int>(9)));
+    EXPECT_EQ(payload.use_count(), 1);
+}
+
+TEST(MulticastRingTest, ConcurrentConsumers) {
+    constexpr int kItemCount = 10000;
+    MulticastRing<int> ring(8);
+
+    std::vector<MulticastRing<int>::Reader> readers;
+    for (int idx = 0; idx < 3; ++idx) {
+        readers.push_back(ring.addConsumer());
+    }
+
+    std::vector<long long> sums(readers.size(), 0);
+    std::vector<std::thread> consumers;
+    for (size_t idx = 0; idx < readers.size(); ++idx) {
+        consumers.emplace_back([&readers, &sums, idx]() {
+            int expected = 0;
+            int value = 0;
+            while (expected < kItemCount) {
+                if (readers[idx].waitAndPopFor(value, std::chrono::milliseconds(10))) {
+                    ASSERT_EQ(value, expected); // In order, nothing skipped.
+                    sums[idx] += value;
+                    ++expected;
+                }
+            }
+        });
+    }
+
+    for (int idx = 0; idx < kItemCount;) {
+        if (ring.tryPublish(idx)) {
+            ++idx;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+    for (auto sum : sums) {
+        EXPECT_EQ(sum, static_cast<long long>(kItemCount) * (kItemCount - 1) / 2);
+    }
+}
@@ -0,0 +1,154 @@
+#include "JoinOperator.hpp"
+#include "utils/logging.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nexusflow { namespace core {
+
+JoinOperator::JoinOperator(size_t inputCount, JoinOptions options)
+    : m_inputCount(inputCount), m_options(std::move(options)), m_pending(m_options.maxPending + 1) {
+    if (m_options.maxPending == 0) {
+        m_options.maxPending = 1;
+    }
+    m_options.inputBudgets.resize(m_inputCount, m_options.timeout);
+
+    switch (m_options.policy) {
+        case JoinPolicy::K_OF_N: m_earlyCount = std::min(std::max<size_t>(m_options.minInputs, 1), m_inputCount); break;
+        case JoinPolicy::FIRST_WINS: m_earlyCount = 1; break;
+        default: break;
+    }
+}
+
+bool JoinOperator::Add(size_t inputIndex, uint64_t correlationId, Message msg, Clock::time_point now,
+                       std::vector<Message>& completed) {
+    if (inputIndex >= m_inputCount) {
+        return false;
+    }
+
+    // A single input completes every group by itself.
+    if (m_inputCount == 1) {
+        completed.clear();
+        completed.push_back(std::move(msg));
+        ++m_stats.joinedCount;
+        return true;
+    }
+
+    if (m_pending.find(correlationId) == nullptr && m_pending.size() >= m_options.maxPending) {
+        // Evict the group closest to its deadline, it is the oldest one.
+        DiscardStaleDeadlines();
+        if (!m_deadlines.empty()) {
+            const uint64_t evictedId = m_deadlines.top().correlationId;
+            LOG_DEBUG("Join cache full, evicting message with ID: {}", evictedId);
+            if (!m_pending.find(evictedId)->isHandedOver) {
+                ++m_stats.evictedCount;
+            }
+            m_pending.erase(evictedId);
+            m_deadlines.pop();
+        }
+    }
+
+    bool inserted = false;
+    PendingGroup& group = m_pending.emplace(correlationId, inserted);
+    if (inserted) {
+        group.serial = m_nextSerial++;
+        group.start = now;
+        group.parts.resize(m_inputCount);
+        group.arrived.assign(m_inputCount, false);
+    }
+
+    if (group.isHandedOver && !group.arrived[inputIndex]) {
+        ++m_stats.lateCount;
+    }
+    if (!group.arrived[inputIndex]) {
+        group.arrived[inputIndex] = true;
+        ++group.arrivedCount;
+    }
+
+    if (group.isHandedOver) {
+        // A straggler of a group handed over early. Forget the group once nothing else can arrive.
+        if (group.arrivedCount == m_inputCount) {
+            m_pending.erase(correlationId);
+        }
+        return false;
+    }
+    group.parts[inputIndex] = std::move(msg);
+
+    if (group.arrivedCount == m_inputCount) {
+        HandOver(group, completed);
+        m_pending.erase(correlationId);
+        return true;
+    }
+
+    // The deadline only moves closer as inputs deliver, a new heap entry makes the old one stale.
+    auto deadline = GetDeadline(group);
+    if (inserted || deadline < group.deadline) {
+        group.deadline = deadline;
+        m_deadlines.push({group.deadline, correlationId, group.serial});
+    }
+
+    if (m_earlyCount > 0 && group.arrivedCount >= m_earlyCount) {
+        HandOver(group, completed);
+        return true;
+    }
+    return false;
+}
+
+bool JoinOperator::Expire(Clock::time_point now, std::vector<Message>& completed) {
+    for (DiscardStaleDeadlines(); !m_deadlines.empty() && m_deadlines.top().deadline <= now; DiscardStaleDeadlines()) {
+        const uint64_t correlationId = m_deadlines.top().correlationId;
+        m_deadlines.pop();
+
+        PendingGroup* group = m_pending.find(correlationId);
+        if (!group->isHandedOver && m_options.policy == JoinPolicy::EMIT_PARTIAL_ON_TIMEOUT) {
+            HandOver(*group, completed);
+            m_pending.erase(correlationId);
+            return true;
+        }
+        if (!group->isHandedOver) {
+            LOG_DEBUG("Timeout for message with ID: {}, will be removed from cache", correlationId);
+            ++m_stats.expiredCount;
+        }
+        m_pending.erase(correlationId);
+    }
+    return false;
+}
+
+JoinOperator::Clock::time_point JoinOperator::GetNextDeadline() {
+    DiscardStaleDeadlines();
+    return m_deadlines.empty() ? Clock::time_point::max() : m_deadlines.top().deadline;
+}
+
+void JoinOperator::DiscardStaleDeadlines() {
+    while (!m_deadlines.empty()) {
+        const auto& top = m_deadlines.top();
+        const PendingGroup* group = m_pending.find(top.correlationId);
+        if (group != nullptr && group->serial == top.serial && group->deadline == top.deadline) {
+            return;
+        }
+        m_deadlines.pop();
+    }
+}
+
+JoinOperator::Clock::time_point JoinOperator::GetDeadline(const PendingGroup& group) const {
+    std::chrono::milliseconds budget{0};
+    for (size_t idx = 0; idx < m_inputCount; ++idx) {
+        if (!group.arrived[idx]) {
+            budget = std::max(budget, m_options.inputBudgets[idx]);
+        }
+    }
+    return group.start + budget;
+}
+
+void JoinOperator::HandOver(PendingGroup& group, std::vector<Message>& completed) {
+    completed.clear();
+    completed.swap(group.parts);
+    group.isHandedOver = true;
+
+    ++m_stats.joinedCount;
+    if (group.arrivedCount < m_inputCount) {
+        ++m_stats.partialCount;
+    }
+}
+
+}} // namespace nexusflow::core
@@ -0,0 +1,135 @@
+#ifndef NEXUSFLOW_JOIN_OPERATOR_HPP
+#define NEXUSFLOW_JOIN_OPERATOR_HPP
+
+#include "common/FlatHashMap.hpp"
+#include "core/TimerService.hpp"
+#include "nexusflow/Message.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace nexusflow { namespace core {
+
+// When a `JoinOperator` hands a group to the module, set by the module's `joinPolicy` config.
+enum class JoinPolicy {
+    ALL, // "all" (default): once every input delivered, incomplete groups are dropped at their deadline.
+    K_OF_N, // "k_of_n": as soon as `minInputs` inputs delivered.
+    FIRST_WINS, // "first_wins": as soon as any input delivered.
+    EMIT_PARTIAL_ON_TIMEOUT, // "emit_partial_on_timeout": once every input delivered, or with what arrived at the deadline.
+};
+
+struct JoinOptions {
+    std::chrono::milliseconds timeout{60000}; // How long a group waits for an input without its own budget.
+    size_t maxPending = 1024; // The maximum number of partial groups, the oldest is evicted beyond it.
+    JoinPolicy policy = JoinPolicy::ALL;
+    size_t minInputs = 1; // The number of inputs that completes a group under `K_OF_N`.
+    // How long a group waits for each input, by input index, counted from the group's first message.
+    // The deadline of a group is the largest budget of its missing inputs. Inputs without one use `timeout`.
+    std::vector<std::chrono::milliseconds> inputBudgets;
+};
+
+struct JoinStats {
+    uint64_t joinedCount = 0; // Groups handed to the module, complete or not.
+    uint64_t partialCount = 0; // Groups handed to the module without a message from every input.
+    uint64_t lateCount = 0; // Messages dropped because their group had already been handed over.
+    uint64_t expiredCount = 0; // Partial groups dropped because they timed out.
+    uint64_t evictedCount = 0; // Partial groups dropped because `maxPending` was reached.
+    uint64_t unmatchedCount = 0; // Messages a time-window join dropped for lack of a match within the tolerance.
+};
+
+/**
+ * @class JoinOperator
+ * @brief Groups messages from several inputs by a 64-bit correlation id.
+ *
+ * Partial groups are indexed by correlation id in a flat hash map, and their deadlines sit
+ * in a min-heap, so neither adding a message nor expiring groups scans the pending set.
+ * Heap entries of groups that completed, or whose deadline moved, are discarded lazily when
+ * they reach the top.
+ *
+ * A group handed over before every input delivered, under `K_OF_N` or `FIRST_WINS`, stays
+ * behind without its messages until the remaining inputs delivered or its deadline passed,
+ * so the stragglers are dropped instead of starting a new group.
+ *
+ * The operator is not thread-safe, it is driven by the worker thread of the joining module.
+ */
+class JoinOperator {
+public:
+    using Clock = TimerService::Clock;
+
+    JoinOperator(size_t inputCount, JoinOptions options);
+
+    /**
+     * @brief Adds a message received on an input.
+     * A second message for the same id on the same input replaces the first.
+     * @param inputIndex The index of the input the message arrived on.
+     * @param correlationId The id messages of one group share.
+     * @param now The current time, a new group starts at `now`.
+     * @param completed Receives one message per input, by input index, if the group is complete.
+     *                  The message of an input that did not deliver is empty.
+     * @return true if this message completed its group, according to the policy.
+     */
+    bool Add(size_t inputIndex, uint64_t correlationId, Message msg, Clock::time_point now, std::vector<Message>& completed);
+
+    /**
+     * @brief Handles the groups whose deadline has passed.
+     * Incomplete groups are dropped, or with `EMIT_PARTIAL_ON_TIMEOUT` handed back one at a time.
+     * @param completed Receives the messages of a partial group, as with `Add()`.
+     * @return true if `completed` received a group, call again until it returns false.
+     */
+    bool Expire(Clock::time_point now, std::vector<Message>& completed);
+
+    /**
+     * @brief Gets the earliest deadline of the partial groups.
+     * @return The deadline, or `Clock::time_point::max()` if nothing is pending.
+     */
+    Clock::time_point GetNextDeadline();
+
+    size_t GetPendingCount() const { return m_pending.size(); }
+
+    const JoinStats& GetStats() const { return m_stats; }
+
+private:
+    struct PendingGroup {
+        uint64_t serial = 0; // Tells a group apart from an earlier one with the same id.
+        Clock::time_point start;
+        Clock::time_point deadline;
+        bool isHandedOver = false; // Only waits to drop the stragglers.
+        size_t arrivedCount = 0;
+        std::vector<Message> parts; // By input index.
+        std::vector<bool> arrived; // By input index.
+    };
+
+    struct Deadline {
+        Clock::time_point deadline;
+        uint64_t correlationId;
+        uint64_t serial;
+
+        bool operator>(const Deadline& other) const { return deadline > other.deadline; }
+    };
+
+    // Pops heap entries of groups that no longer exist or whose deadline moved.
+    void DiscardStaleDeadlines();
+
+    // The deadline of a group: its start plus the largest budget of its missing inputs.
+    Clock::time_point GetDeadline(const PendingGroup& group) const;
+
+    // Moves the messages of a group into `completed` and updates the stats.
+    void HandOver(PendingGroup& group, std::vector<Message>& completed);
+
+    size_t m_inputCount;
+    JoinOptions m_options;
+    size_t m_earlyCount = 0; // The number of inputs that hands a group over before all delivered, 0 if none does.
+    uint64_t m_nextSerial = 1;
+
+    FlatHashMap<PendingGroup> m_pending;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> m_deadlines;
+    JoinStats m_stats;
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_JOIN_OPERATOR_HPP
@@ -0,0 +1,55 @@
+#include "LatestValueJoin.hpp"
+
+#include <utility>
+
+namespace nexusflow { namespace core {
+
+LatestValueJoin::LatestValueJoin(size_t inputCount, size_t primaryIndex, std::chrono::nanoseconds maxStaleness)
+    : m_inputCount(inputCount), m_primaryIndex(primaryIndex), m_maxStaleness(maxStaleness), m_latest(inputCount) {}
+
+bool LatestValueJoin::Add(size_t inputIndex, Message msg, std::vector<Message>& completed) {
+    if (inputIndex >= m_inputCount) {
+        return false;
+    }
+    if (inputIndex != m_primaryIndex) {
+        m_latest[inputIndex] = std::move(msg);
+        return false;
+    }
+
+    const uint64_t eventTime = msg.GetMetaData().eventTime;
+    const uint64_t maxStaleness = static_cast<uint64_t>(m_maxStaleness.count());
+    bool isPartial = false;
+
+    // The held messages are shared with the group, not moved: they are held for the next primary message too.
+    completed.assign(m_inputCount, Message());
+    for (size_t idx = 0; idx < m_inputCount; ++idx) {
+        if (idx == m_primaryIndex) {
+            continue;
+        }
+        const Message& held = m_latest[idx];
+        if (!held.HasData() ||
+            (maxStaleness > 0 && eventTime > held.GetMetaData().eventTime &&
+             eventTime - held.GetMetaData().eventTime > maxStaleness)) {
+            isPartial = true;
+            continue;
+        }
+        completed[idx] = held;
+    }
+    completed[m_primaryIndex] = std::move(msg);
+
+    ++m_stats.joinedCount;
+    if (isPartial) {
+        ++m_stats.partialCount;
+    }
+    return true;
+}
+
+size_t LatestValueJoin::GetPendingCount() const {
+    size_t pendingCount = 0;
+    for (const auto& held : m_latest) {
+        pendingCount += held.HasData() ? 1 : 0;
+    }
+    return pendingCount;
+}
+
+}} // namespace nexusflow::core
@@ -0,0 +1,54 @@
+#ifndef NEXUSFLOW_LATEST_VALUE_JOIN_HPP
+#define NEXUSFLOW_LATEST_VALUE_JOIN_HPP
+
+#include "core/JoinOperator.hpp"
+#include "nexusflow/Message.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace nexusflow { namespace core {
+
+/**
+ * @class LatestValueJoin
+ * @brief Pairs every message of a primary input with the latest message of each secondary input.
+ *
+ * A sample-and-hold join for inputs with mismatched rates: the primary input triggers a group,
+ * the secondary inputs only replace the one message held for them. A held message whose event
+ * time is more than `maxStaleness` behind the primary's is left out of the group.
+ *
+ * The join is not thread-safe, it is driven by the worker thread of the joining module.
+ */
+class LatestValueJoin {
+public:
+    /**
+     * @param maxStaleness The largest event time gap between the primary and a held message, 0 means unlimited.
+     */
+    LatestValueJoin(size_t inputCount, size_t primaryIndex, std::chrono::nanoseconds maxStaleness);
+
+    /**
+     * @brief Adds a message received on an input.
+     * @param completed Receives one message per input, by input index, if `inputIndex` is the primary input.
+     *                  The message of a secondary input with nothing fresh held is empty.
+     * @return true if a group was emitted.
+     */
+    bool Add(size_t inputIndex, Message msg, std::vector<Message>& completed);
+
+    // The number of held secondary messages.
+    size_t GetPendingCount() const;
+
+    const JoinStats& GetStats() const { return m_stats; }
+
+private:
+    size_t m_inputCount;
+    size_t m_primaryIndex;
+    std::chrono::nanoseconds m_maxStaleness;
+
+    std::vector<Message> m_latest; // By input index, the primary's slot stays empty.
+    JoinStats m_stats;
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_LATEST_VALUE_JOIN_HPP
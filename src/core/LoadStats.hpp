@@ -0,0 +1,47 @@
+#ifndef NEXUSFLOW_LOAD_STATS_HPP
+#define NEXUSFLOW_LOAD_STATS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace nexusflow { namespace core {
+
+/**
+ * @class LoadStats
+ * @brief Load figures a Worker publishes for the dispatchers feeding it.
+ *
+ * The worker thread is the only writer; upstream dispatchers read the values lock-free
+ * to pick the least loaded of several equivalent consumers.
+ */
+class LoadStats {
+public:
+    // The weight of a new sample is 1 / 2^kEwmaShift.
+    static constexpr int kEwmaShift = 3;
+
+    /**
+     * @brief Folds the per-message processing time of a batch into the moving average.
+     */
+    void RecordLatency(uint64_t latencyNs) {
+        uint64_t average = m_ewmaLatencyNs.load(std::memory_order_relaxed);
+        if (average == 0) {
+            average = latencyNs; // The first sample seeds the average.
+        } else {
+            int64_t delta = static_cast<int64_t>(latencyNs) - static_cast<int64_t>(average);
+            average = static_cast<uint64_t>(static_cast<int64_t>(average) + delta / (1 << kEwmaShift));
+        }
+        m_ewmaLatencyNs.store(average, std::memory_order_relaxed);
+    }
+
+    // The exponentially weighted moving average of the processing time per message, 0 before the first sample.
+    uint64_t GetLatencyNs() const { return m_ewmaLatencyNs.load(std::memory_order_relaxed); }
+
+    // Forgets the samples, the next one seeds the average again.
+    void Reset() { m_ewmaLatencyNs.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_ewmaLatencyNs{0};
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_LOAD_STATS_HPP
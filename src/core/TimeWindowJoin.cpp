@@ -0,0 +1,160 @@
+#include "TimeWindowJoin.hpp"
+#include "utils/logging.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace nexusflow { namespace core {
+
+TimeWindowJoin::TimeWindowJoin(size_t inputCount, TimeWindowJoinOptions options)
+    : m_inputCount(inputCount), m_options(options), m_buffers(inputCount) {
+    if (m_options.maxPending == 0) {
+        m_options.maxPending = 1;
+    }
+}
+
+void TimeWindowJoin::Add(size_t inputIndex, Message msg) {
+    if (inputIndex >= m_inputCount) {
+        return;
+    }
+
+    const uint64_t eventTime = msg.GetMetaData().eventTime;
+    m_latestEventTime = std::max(m_latestEventTime, eventTime);
+
+    // Inputs are nearly always in order, a late message is inserted at its place.
+    auto& buffer = m_buffers[inputIndex];
+    if (buffer.empty() || buffer.back().eventTime <= eventTime) {
+        buffer.push_back({eventTime, std::move(msg)});
+    } else {
+        auto it = std::upper_bound(buffer.begin(), buffer.end(), eventTime,
+                                   [](uint64_t time, const Entry& entry) { return time < entry.eventTime; });
+        buffer.insert(it, {eventTime, std::move(msg)});
+    }
+    if (buffer.size() > m_options.maxPending) {
+        buffer.pop_front();
+        ++m_stats.evictedCount;
+    }
+
+    // Drop what fell out of the window, on every input.
+    const uint64_t window = static_cast<uint64_t>(m_options.window.count());
+    if (m_latestEventTime > window) {
+        const uint64_t cutoff = m_latestEventTime - window;
+        for (auto& inputBuffer : m_buffers) {
+            while (!inputBuffer.empty() && inputBuffer.front().eventTime < cutoff) {
+                inputBuffer.pop_front();
+                ++m_stats.expiredCount;
+            }
+        }
+    }
+}
+
+bool TimeWindowJoin::Poll(std::vector<Message>& completed) {
+    if (!m_releasedGroups.empty()) {
+        completed = std::move(m_releasedGroups.front());
+        m_releasedGroups.pop_front();
+        return true;
+    }
+    return Match(completed);
+}
+
+bool TimeWindowJoin::Match(std::vector<Message>& completed) {
+    const uint64_t tolerance = static_cast<uint64_t>(m_options.tolerance.count());
+    while (true) {
+        // A group needs a candidate on every input.
+        size_t pivotIndex = 0;
+        for (size_t idx = 0; idx < m_inputCount; ++idx) {
+            if (m_buffers[idx].empty()) {
+                return false;
+            }
+            if (m_buffers[idx].front().eventTime < m_buffers[pivotIndex].front().eventTime) {
+                pivotIndex = idx;
+            }
+        }
+
+        auto& pivotBuffer = m_buffers[pivotIndex];
+        const uint64_t spread = GetSpread(pivotIndex, pivotBuffer.front().eventTime);
+        if (spread > tolerance) {
+            LOG_TRACE("No match within tolerance for event time {}, dropping it", pivotBuffer.front().eventTime);
+            pivotBuffer.pop_front();
+            ++m_stats.unmatchedCount;
+            continue;
+        }
+        if (pivotBuffer.size() > 1) {
+            // The spread grows again beyond the nearest successor, so only the next one needs a look.
+            if (GetSpread(pivotIndex, pivotBuffer[1].eventTime) < spread) {
+                pivotBuffer.pop_front(); // Its successor is the nearer match.
+                ++m_stats.unmatchedCount;
+                continue;
+            }
+        } else if (MayGetNearerSuccessor(pivotIndex, pivotBuffer.front().eventTime)) {
+            return false; // Held until the successor arrives, or the watermark passes it.
+        }
+
+        completed.clear();
+        for (auto& buffer : m_buffers) {
+            completed.push_back(std::move(buffer.front().msg));
+            buffer.pop_front();
+        }
+        ++m_stats.joinedCount;
+        return true;
+    }
+}
+
+void TimeWindowJoin::Advance(uint64_t watermark) {
+    m_watermark = std::max(m_watermark, watermark);
+    // The held groups whose nearer successor can no longer arrive are complete, release them before the cutoff.
+    std::vector<Message> completed;
+    while (Match(completed)) {
+        m_releasedGroups.push_back(std::move(completed));
+    }
+
+    const uint64_t tolerance = static_cast<uint64_t>(m_options.tolerance.count());
+    if (watermark <= tolerance) {
+        return;
+    }
+    const uint64_t cutoff = watermark - tolerance;
+    for (auto& buffer : m_buffers) {
+        while (!buffer.empty() && buffer.front().eventTime < cutoff) {
+            buffer.pop_front();
+            ++m_stats.unmatchedCount;
+        }
+    }
+}
+
+size_t TimeWindowJoin::GetPendingCount() const {
+    size_t pendingCount = 0;
+    for (const auto& buffer : m_buffers) {
+        pendingCount += buffer.size();
+    }
+    pendingCount += m_releasedGroups.size() * m_inputCount;
+    return pendingCount;
+}
+
+uint64_t TimeWindowJoin::GetSpread(size_t pivotIndex, uint64_t eventTime) const {
+    uint64_t spread = 0;
+    for (size_t idx = 0; idx < m_inputCount; ++idx) {
+        if (idx == pivotIndex) {
+            continue;
+        }
+        const uint64_t headTime = m_buffers[idx].front().eventTime;
+        spread = std::max(spread, headTime > eventTime ? headTime - eventTime : eventTime - headTime);
+    }
+    return spread;
+}
+
+bool TimeWindowJoin::MayGetNearerSuccessor(size_t pivotIndex, uint64_t pivotTime) const {
+    // The heads lie at or after the pivot. A successor at `eventTime` is at least `eventTime - nearestHead`
+    // from the nearest head, so from `nearestHead + farthestHead - pivotTime` on it is no nearer than the pivot.
+    uint64_t nearestHead = UINT64_MAX;
+    uint64_t farthestHead = 0;
+    for (size_t idx = 0; idx < m_inputCount; ++idx) {
+        if (idx == pivotIndex) {
+            continue;
+        }
+        nearestHead = std::min(nearestHead, m_buffers[idx].front().eventTime);
+        farthestHead = std::max(farthestHead, m_buffers[idx].front().eventTime);
+    }
+    return m_inputCount > 1 && m_watermark < nearestHead + farthestHead - pivotTime;
+}
+
+}} // namespace nexusflow::core
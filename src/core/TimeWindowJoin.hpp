@@ -0,0 +1,96 @@
+#ifndef NEXUSFLOW_TIME_WINDOW_JOIN_HPP
+#define NEXUSFLOW_TIME_WINDOW_JOIN_HPP
+
+#include "core/JoinOperator.hpp"
+#include "nexusflow/Message.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace nexusflow { namespace core {
+
+struct TimeWindowJoinOptions {
+    std::chrono::nanoseconds tolerance{std::chrono::milliseconds(20)}; // The largest event time gap inside a group.
+    std::chrono::nanoseconds window{std::chrono::seconds(1)}; // How far behind the newest event time a message is kept.
+    size_t maxPending = 1024; // The maximum number of messages buffered per input, the oldest is evicted beyond it.
+};
+
+/**
+ * @class TimeWindowJoin
+ * @brief Groups messages from several inputs whose event times lie within a tolerance.
+ *
+ * Every input has a buffer sorted by `MessageMeta::eventTime`. The message with the earliest
+ * event time across all inputs is the pivot; since the buffers are sorted, the nearest candidate
+ * on every other input is the head of its buffer. If every head lies within the tolerance the
+ * group is emitted, unless the pivot's successor on its own input is a nearer match for them, in
+ * which case the pivot is dropped. If a head lies beyond the tolerance, no message of that input
+ * can ever match the pivot, and the pivot is dropped as unmatched.
+ *
+ * Until the pivot has a successor, the group is held: a successor still to come may be the nearer
+ * match. The watermark releases it once no such successor can arrive any more, see `Advance()`.
+ * Inputs are expected in event time order; a late message is still inserted at its place.
+ *
+ * Messages older than `window` behind the newest event time are dropped, so the memory
+ * is bounded by the window, not by the backlog of a stalled input.
+ *
+ * The join is not thread-safe, it is driven by the worker thread of the joining module.
+ */
+class TimeWindowJoin {
+public:
+    TimeWindowJoin(size_t inputCount, TimeWindowJoinOptions options);
+
+    /**
+     * @brief Adds a message received on an input. Call `Poll()` afterwards to collect the groups it completed.
+     */
+    void Add(size_t inputIndex, Message msg);
+
+    /**
+     * @brief Takes the next complete group.
+     * @param completed Receives one message per input, by input index.
+     * @return true if a group was complete.
+     */
+    bool Poll(std::vector<Message>& completed);
+
+    /**
+     * @brief Drops the messages more than the tolerance behind the watermark of all inputs.
+     * No message to come lies within the tolerance of them, so they can never be matched.
+     * Groups held for a successor are released first, and kept for `Poll()`; call it afterwards.
+     * @param watermark The smallest watermark of all inputs, in ns.
+     */
+    void Advance(uint64_t watermark);
+
+    size_t GetPendingCount() const;
+
+    const JoinStats& GetStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        uint64_t eventTime;
+        Message msg;
+    };
+
+    // Takes the next group out of the buffers, the body of `Poll()` without the released groups.
+    bool Match(std::vector<Message>& completed);
+
+    // The largest event time distance between `eventTime` and the heads of all inputs but `pivotIndex`.
+    uint64_t GetSpread(size_t pivotIndex, uint64_t eventTime) const;
+
+    // Whether a message still to come on the pivot's input may be a nearer match for the other heads than the pivot.
+    bool MayGetNearerSuccessor(size_t pivotIndex, uint64_t pivotTime) const;
+
+    size_t m_inputCount;
+    TimeWindowJoinOptions m_options;
+    uint64_t m_latestEventTime = 0;
+    uint64_t m_watermark = 0; // No message with an earlier event time arrives any more.
+
+    std::vector<std::deque<Entry>> m_buffers; // By input index, sorted by event time.
+    std::deque<std::vector<Message>> m_releasedGroups; // Completed by `Advance()`, not polled yet.
+    JoinStats m_stats;
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_TIME_WINDOW_JOIN_HPP
@@ -0,0 +1,88 @@
+#include "TimerService.hpp"
+
+namespace nexusflow { namespace core {
+
+TimerService& TimerService::Global() {
+    static TimerService instance;
+    return instance;
+}
+
+TimerService::~TimerService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopFlag = true;
+    }
+    m_cond.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+TimerService::TimerId TimerService::Schedule(Clock::time_point deadline, std::function<void()> callback) {
+    TimerId timerId;
+    bool isEarliest;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&TimerService::Run, this);
+        }
+        timerId = m_nextTimerId++;
+        m_callbacks.emplace(timerId, std::move(callback));
+        isEarliest = m_deadlines.empty() || deadline < m_deadlines.top().deadline;
+        m_deadlines.push({deadline, timerId});
+    }
+    if (isEarliest) {
+        m_cond.notify_one(); // The thread sleeps until a later deadline.
+    }
+    return timerId;
+}
+
+bool TimerService::Cancel(TimerId timerId) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // The heap entry stays behind and is skipped when it reaches the top.
+    if (m_callbacks.erase(timerId) > 0) {
+        return true;
+    }
+    if (std::this_thread::get_id() != m_thread.get_id()) {
+        m_runningDone.wait(lock, [this, timerId] { return m_runningTimerId != timerId; });
+    }
+    return false;
+}
+
+size_t TimerService::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_callbacks.size();
+}
+
+void TimerService::Run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopFlag) {
+        if (m_deadlines.empty()) {
+            m_cond.wait(lock);
+            continue;
+        }
+
+        Entry entry = m_deadlines.top();
+        auto it = m_callbacks.find(entry.timerId);
+        if (it == m_callbacks.end()) {
+            m_deadlines.pop(); // Cancelled.
+            continue;
+        }
+        if (Clock::now() < entry.deadline) {
+            m_cond.wait_until(lock, entry.deadline);
+            continue; // An earlier timer may have been scheduled meanwhile.
+        }
+
+        m_deadlines.pop();
+        std::function<void()> callback = std::move(it->second);
+        m_callbacks.erase(it);
+        m_runningTimerId = entry.timerId;
+        lock.unlock();
+        callback();
+        lock.lock();
+        m_runningTimerId = kInvalidTimerId;
+        m_runningDone.notify_all();
+    }
+}
+
+}} // namespace nexusflow::core
@@ -0,0 +1,81 @@
+#ifndef NEXUSFLOW_TIMER_SERVICE_HPP
+#define NEXUSFLOW_TIMER_SERVICE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace nexusflow { namespace core {
+
+/**
+ * @class TimerService
+ * @brief The single monotonic time base and timer thread of the framework.
+ *
+ * Every internal timeout (batch closure, join expiry, ...) is measured with `Clock` and,
+ * when a worker has to sleep until one, armed here. The callbacks run on the timer thread
+ * and must be short, typically they only wake the owning worker up.
+ *
+ * The thread is started on the first `Schedule()`.
+ */
+class TimerService {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;
+
+    static constexpr TimerId kInvalidTimerId = 0;
+
+    // The process-wide instance.
+    static TimerService& Global();
+
+    TimerService() = default;
+    ~TimerService();
+
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    static Clock::time_point Now() { return Clock::now(); }
+
+    /**
+     * @brief Runs `callback` on the timer thread once `deadline` has passed.
+     * @return The id of the timer, to cancel it.
+     */
+    TimerId Schedule(Clock::time_point deadline, std::function<void()> callback);
+
+    /**
+     * @brief Cancels a timer. If its callback is running, waits until it returns.
+     * @return true if the timer was still pending.
+     */
+    bool Cancel(TimerId timerId);
+
+    size_t GetPendingCount() const;
+
+private:
+    struct Entry {
+        Clock::time_point deadline;
+        TimerId timerId;
+
+        bool operator>(const Entry& other) const { return deadline > other.deadline; }
+    };
+
+    void Run();
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_deadlines;
+    std::unordered_map<TimerId, std::function<void()>> m_callbacks; // Only pending timers.
+    TimerId m_nextTimerId = 1;
+    TimerId m_runningTimerId = kInvalidTimerId;
+    std::condition_variable m_runningDone;
+    bool m_stopFlag = false;
+    std::thread m_thread;
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_TIMER_SERVICE_HPP
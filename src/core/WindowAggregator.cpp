@@ -0,0 +1,200 @@
+#include "WindowAggregator.hpp"
+#include "utils/logging.hpp"
+
+#include <algorithm>
+
+namespace nexusflow { namespace core {
+
+WindowAggregator::WindowAggregator(WindowOptions options) : m_options(options) {
+    if (m_options.type == WindowType::SESSION) {
+        m_options.measure = WindowMeasure::TIME;
+    }
+    m_options.size = std::max<uint64_t>(m_options.size, 1);
+    m_options.gap = std::max<uint64_t>(m_options.gap, 1);
+    if (m_options.type != WindowType::SLIDING || m_options.slide == 0 || m_options.slide > m_options.size) {
+        m_options.slide = m_options.size;
+    }
+    if (m_options.size % m_options.slide != 0) {
+        const uint64_t size = (m_options.size / m_options.slide + 1) * m_options.slide;
+        LOG_WARN("Window size {} is not a multiple of its slide {}, using {}", m_options.size, m_options.slide, size);
+        m_options.size = size;
+    }
+}
+
+void WindowAggregator::Add(uint64_t key, double value, uint64_t eventTime, std::vector<WindowAggregate>& closed) {
+    if (m_options.measure == WindowMeasure::COUNT) {
+        AddByCount(key, m_keys[key], value, eventTime, closed);
+        return;
+    }
+
+    Advance(eventTime, closed);
+    auto it = m_keys.emplace(key, KeyState()).first;
+    KeyState& state = it->second;
+    const bool isAdded = m_options.type == WindowType::SESSION ? AddToSession(state, value, eventTime)
+                                                                : AddByTime(state, value, eventTime);
+    if (!isAdded) {
+        ++m_stats.lateCount;
+        if (state.panes.empty()) {
+            m_keys.erase(it);
+        }
+        return;
+    }
+    m_nextClose = std::min(m_nextClose, state.nextClose);
+}
+
+void WindowAggregator::Advance(uint64_t eventTime, std::vector<WindowAggregate>& closed) {
+    m_eventTime = std::max(m_eventTime, eventTime);
+    if (m_eventTime < m_nextClose) {
+        return;
+    }
+
+    m_nextClose = std::numeric_limits<uint64_t>::max();
+    for (auto it = m_keys.begin(); it != m_keys.end();) {
+        KeyState& state = it->second;
+        if (state.nextClose <= m_eventTime) {
+            if (m_options.type == WindowType::SESSION) {
+                Emit(it->first, state, 0, 0, closed);
+                state.panes.clear();
+            } else {
+                CloseTimeWindows(it->first, state, closed);
+            }
+        }
+        if (state.panes.empty()) {
+            it = m_keys.erase(it);
+            continue;
+        }
+        m_nextClose = std::min(m_nextClose, state.nextClose);
+        ++it;
+    }
+}
+
+void WindowAggregator::Flush(std::vector<WindowAggregate>& closed) {
+    if (m_options.measure == WindowMeasure::TIME) {
+        Advance(std::numeric_limits<uint64_t>::max(), closed);
+        return;
+    }
+
+    // The last pane of a count window is only emitted once full.
+    const size_t paneCount = static_cast<size_t>(m_options.size / m_options.slide);
+    for (auto& entry : m_keys) {
+        KeyState& state = entry.second;
+        if (state.panes.empty() || state.panes.back().aggregate.count >= m_options.slide) {
+            continue;
+        }
+        while (state.panes.size() > paneCount) {
+            RetractFront(state);
+        }
+        Emit(entry.first, state, 0, 0, closed);
+    }
+    m_keys.clear();
+}
+
+void WindowAggregator::AddToPane(KeyState& state, Pane& pane, double value, uint64_t eventTime) {
+    WindowAggregate& aggregate = pane.aggregate;
+    if (aggregate.count == 0) {
+        aggregate.windowStart = aggregate.windowEnd = eventTime;
+        aggregate.min = aggregate.max = value;
+    } else {
+        aggregate.windowStart = std::min(aggregate.windowStart, eventTime);
+        aggregate.windowEnd = std::max(aggregate.windowEnd, eventTime);
+        aggregate.min = std::min(aggregate.min, value);
+        aggregate.max = std::max(aggregate.max, value);
+    }
+    ++aggregate.count;
+    aggregate.sum += value;
+
+    ++state.count;
+    state.sum += value;
+}
+
+void WindowAggregator::RetractFront(KeyState& state) {
+    const WindowAggregate& aggregate = state.panes.front().aggregate;
+    state.count -= aggregate.count;
+    state.sum -= aggregate.sum;
+    state.panes.pop_front();
+    if (state.panes.empty()) {
+        state.sum = 0.0; // Do not carry rounding errors into the next window.
+    }
+}
+
+bool WindowAggregator::AddByTime(KeyState& state, double value, uint64_t eventTime) {
+    const uint64_t paneStart = eventTime - eventTime % m_options.slide;
+    // Every pane ending at or before the event time has closed. Only the pane holding it is open.
+    if (paneStart + m_options.slide <= m_eventTime) {
+        return false;
+    }
+    if (state.panes.empty()) {
+        state.nextClose = paneStart + m_options.slide;
+    }
+    if (state.panes.empty() || state.panes.back().start != paneStart) {
+        state.panes.push_back({paneStart, WindowAggregate()});
+    }
+    AddToPane(state, state.panes.back(), value, eventTime);
+    return true;
+}
+
+bool WindowAggregator::AddToSession(KeyState& state, double value, uint64_t eventTime) {
+    if (state.panes.empty()) {
+        if (eventTime + m_options.gap <= m_eventTime) {
+            return false; // Its session would have closed already.
+        }
+        state.panes.push_back({eventTime, WindowAggregate()});
+    }
+    Pane& session = state.panes.back();
+    AddToPane(state, session, value, eventTime);
+    state.nextClose = session.aggregate.windowEnd + m_options.gap;
+    return true;
+}
+
+void WindowAggregator::AddByCount(uint64_t key, KeyState& state, double value, uint64_t eventTime,
+                                  std::vector<WindowAggregate>& closed) {
+    if (state.panes.empty() || state.panes.back().aggregate.count >= m_options.slide) {
+        state.panes.push_back({0, WindowAggregate()});
+    }
+    AddToPane(state, state.panes.back(), value, eventTime);
+    if (state.panes.back().aggregate.count < m_options.slide) {
+        return;
+    }
+
+    const size_t paneCount = static_cast<size_t>(m_options.size / m_options.slide);
+    while (state.panes.size() > paneCount) {
+        RetractFront(state);
+    }
+    Emit(key, state, 0, 0, closed);
+}
+
+void WindowAggregator::CloseTimeWindows(uint64_t key, KeyState& state, std::vector<WindowAggregate>& closed) {
+    // A window closes every slide while a pane of the key lies within it. The panes left are those of the next window.
+    while (!state.panes.empty() && state.nextClose <= m_eventTime) {
+        const uint64_t windowEnd = state.nextClose;
+        Emit(key, state, windowEnd > m_options.size ? windowEnd - m_options.size : 0, windowEnd, closed);
+        state.nextClose += m_options.slide;
+        const uint64_t nextStart = state.nextClose > m_options.size ? state.nextClose - m_options.size : 0;
+        while (!state.panes.empty() && state.panes.front().start < nextStart) {
+            RetractFront(state);
+        }
+    }
+}
+
+void WindowAggregator::Emit(uint64_t key, const KeyState& state, uint64_t windowStart, uint64_t windowEnd,
+                            std::vector<WindowAggregate>& closed) {
+    WindowAggregate result;
+    for (const auto& pane : state.panes) {
+        const bool isFirst = result.count == 0;
+        result.Merge(pane.aggregate);
+        result.windowStart = isFirst ? pane.aggregate.windowStart : std::min(result.windowStart, pane.aggregate.windowStart);
+        result.windowEnd = std::max(result.windowEnd, pane.aggregate.windowEnd);
+    }
+    // The count and sum are the running ones, kept up to date by adding and retracting panes.
+    result.key = key;
+    result.count = state.count;
+    result.sum = state.sum;
+    if (windowEnd != 0) {
+        result.windowStart = windowStart;
+        result.windowEnd = windowEnd;
+    }
+    closed.push_back(result);
+    ++m_stats.emittedCount;
+}
+
+}} // namespace nexusflow::core
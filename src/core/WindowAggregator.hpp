@@ -0,0 +1,121 @@
+#ifndef NEXUSFLOW_WINDOW_AGGREGATOR_HPP
+#define NEXUSFLOW_WINDOW_AGGREGATOR_HPP
+
+#include "nexusflow/WindowAggregate.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace nexusflow { namespace core {
+
+// The shape of the windows of a `WindowAggregator`, set by the module's `windowType` config.
+enum class WindowType {
+    TUMBLING, // "tumbling" (default): back-to-back windows of `size`.
+    SLIDING, // "sliding": windows of `size`, one every `slide`.
+    SESSION, // "session": a window per burst of messages, closed after `gap` without one.
+};
+
+// What a window's size counts, set by the module's `windowBy` config. Sessions are always measured in time.
+enum class WindowMeasure {
+    TIME, // "time" (default): event time, in ns.
+    COUNT, // "count": messages of the key.
+};
+
+struct WindowOptions {
+    WindowType type = WindowType::TUMBLING;
+    WindowMeasure measure = WindowMeasure::TIME;
+    uint64_t size = 10000000000; // The length of a window, in ns or messages.
+    uint64_t slide = 0; // The step of a sliding window, in the unit of `size`. Rounded so that it divides `size`.
+    uint64_t gap = 5000000000; // The event time without a message that closes a session, in ns.
+};
+
+struct WindowStats {
+    uint64_t emittedCount = 0; // Windows closed and emitted.
+    uint64_t lateCount = 0; // Messages dropped because their window had already closed.
+};
+
+/**
+ * @class WindowAggregator
+ * @brief Aggregates values over tumbling, sliding or session windows, per key.
+ *
+ * A window never holds its messages, only their aggregate. A sliding window is split into
+ * panes of one `slide` each; a message is added to the newest pane, and when the window
+ * slides its oldest pane is retracted from the running count and sum. The minimum and
+ * maximum cannot be retracted, they are folded over the `size / slide` panes on emission.
+ * So the memory per key is O(size / slide), whatever the message rate.
+ *
+ * Time windows are aligned to multiples of `slide` and close when the event time, the
+ * newest `MessageMeta::eventTime` seen on any key or the watermark passed to `Advance()`,
+ * reaches their end; a message for a window that closed already is dropped as late. Count windows close on the message that fills them.
+ *
+ * The aggregator is not thread-safe, it is driven by the worker thread of its module.
+ */
+class WindowAggregator {
+public:
+    explicit WindowAggregator(WindowOptions options);
+
+    /**
+     * @brief Adds the value of a message to the windows of its key.
+     * @param closed Receives the windows that closed, in the order they closed.
+     */
+    void Add(uint64_t key, double value, uint64_t eventTime, std::vector<WindowAggregate>& closed);
+
+    /**
+     * @brief Advances the event time, closing the time windows and sessions that ended at or before it.
+     * @param closed Receives the windows that closed.
+     */
+    void Advance(uint64_t eventTime, std::vector<WindowAggregate>& closed);
+
+    /**
+     * @brief Closes every open window at the end of the input, as if the event time had run out.
+     * A count window closes with the messages it has. Messages added afterwards are late.
+     * @param closed Receives the windows that closed.
+     */
+    void Flush(std::vector<WindowAggregate>& closed);
+
+    // The number of keys with an open window.
+    size_t GetKeyCount() const { return m_keys.size(); }
+
+    const WindowOptions& GetOptions() const { return m_options; }
+
+    const WindowStats& GetStats() const { return m_stats; }
+
+private:
+    struct Pane {
+        uint64_t start; // The start of the pane's time slot, unused by count windows.
+        WindowAggregate aggregate; // Spans the event times of the pane's first and last message.
+    };
+
+    struct KeyState {
+        std::deque<Pane> panes; // The panes of the current window, oldest first.
+        uint64_t count = 0; // The running count and sum over `panes`.
+        double sum = 0.0;
+        uint64_t nextClose = std::numeric_limits<uint64_t>::max(); // When the next time window or session closes.
+    };
+
+    void AddToPane(KeyState& state, Pane& pane, double value, uint64_t eventTime);
+    void RetractFront(KeyState& state);
+    bool AddByTime(KeyState& state, double value, uint64_t eventTime);
+    bool AddToSession(KeyState& state, double value, uint64_t eventTime);
+    void AddByCount(uint64_t key, KeyState& state, double value, uint64_t eventTime, std::vector<WindowAggregate>& closed);
+    void CloseTimeWindows(uint64_t key, KeyState& state, std::vector<WindowAggregate>& closed);
+
+    // Emits the aggregate of all panes of the key. A zero `windowEnd` spans the event times of the messages.
+    void Emit(uint64_t key, const KeyState& state, uint64_t windowStart, uint64_t windowEnd,
+              std::vector<WindowAggregate>& closed);
+
+    WindowOptions m_options;
+    uint64_t m_eventTime = 0; // The newest event time seen.
+    uint64_t m_nextClose = std::numeric_limits<uint64_t>::max(); // The earliest `nextClose` of all keys.
+
+    std::unordered_map<uint64_t, KeyState> m_keys;
+    WindowStats m_stats;
+};
+
+}} // namespace nexusflow::core
+
+#endif // NEXUSFLOW_WINDOW_AGGREGATOR_HPP
@@ -1,18 +1,57 @@
 #include "Worker.hpp"
+#include "JoinOperator.hpp"
+#include "LatestValueJoin.hpp"
+#include "TimeWindowJoin.hpp"
 #include "nexusflow/ErrorCode.hpp"
+#include "nexusflow/JoinedMessage.hpp"
 #include "nexusflow/Message.hpp"
 #include "utils/logging.hpp"
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 
 namespace nexusflow { namespace core {
 
+namespace {
+
+// Pops messages from an input queue or ring without blocking, until it is empty or the batch is full.
+template <typename Source>
+void DrainInto(Source& source, std::vector<Message>& batchMessage, size_t maxBatchSize) {
+    while (batchMessage.size() < maxBatchSize) {
+        Message message;
+        if (source.tryPop(message)) {
+            batchMessage.push_back(std::move(message));
+        } else {
+            break; // The source is now empty.
+        }
+    }
+}
+
+// The upstream module of an input named "src -> dst".
+std::string GetUpstreamName(const std::string& inputName) { return inputName.substr(0, inputName.find(" -> ")); }
+
+} // namespace
+
 Worker::Worker(const std::shared_ptr<Module>& modulePtr, const ViewPtr<Config>& configPtr) {
     m_modulePtr = modulePtr;
     m_configPtr = configPtr;
     m_stopFlag = false;
+    m_isSyncInputs = m_configPtr->GetValueOrDefault<bool>("syncInputs", m_isSyncInputs);
+
+    // "message_id" is the former name of "correlation_id": a forwarded message's correlation id is its message id.
+    const auto joinMode = m_configPtr->GetValueOrDefault<std::string>("joinMode", "correlation_id");
+    if (joinMode == "time_window") {
+        m_joinMode = JoinMode::TIME_WINDOW;
+    } else if (joinMode == "latest_value") {
+        m_joinMode = JoinMode::LATEST_VALUE;
+    } else if (joinMode != "correlation_id" && joinMode != "message_id") {
+        LOG_WARN("Unknown join mode '{}', falling back to correlation_id.", joinMode);
+    }
 }
 
 Worker::~Worker() {
@@ -22,6 +61,9 @@ Worker::~Worker() {
         LOG_WARN("Worker is still running, stopping it now.");
         Stop();
     }
+    if (m_wakeTimerId != TimerService::kInvalidTimerId) {
+        TimerService::Global().Cancel(m_wakeTimerId); // The callback refers to this worker.
+    }
 }
 
 ErrorCode Worker::Start() {
@@ -36,11 +78,14 @@ ErrorCode Worker::Start() {
     return ErrorCode::SUCCESS;
 }
 
-ErrorCode Worker::Stop() {
+ErrorCode Worker::Stop(bool drain, TimerService::Clock::time_point drainDeadline) {
     // Check if the worker is already stopped.
     if (!m_stopFlag.load()) {
-        LOG_TRACE("Stopping worker for module: {}", m_modulePtr->GetModuleName());
+        LOG_TRACE("Stopping worker for module: {}, drain: {}", m_modulePtr->GetModuleName(), drain);
+        m_isDraining = drain;
+        m_drainDeadline = drainDeadline;
         m_stopFlag.store(true);
+        m_inboxSignal.notify(); // Wakes up the worker if it is waiting for input.
         return ErrorCode::SUCCESS;
     } else {
         LOG_WARN("Worker is already stopped.");
@@ -48,10 +93,20 @@ ErrorCode Worker::Stop() {
     }
 }
 
+void Worker::BeginLoop() {
+    std::lock_guard<std::mutex> lock(m_inputChangeMutex);
+    m_isSourceLoop = m_inputQueueMap.empty() && m_inputRingMap.empty(); // Check if this is a source module.
+    m_isLooping = true;
+}
+
 void Worker::WorkLoop() {
     LOG_DEBUG("Worker for module '{}' started", m_modulePtr->GetModuleName());
 
-    bool isSourceModule = m_inputQueueMap.empty(); // Check if this is a source module.
+    bool isSourceModule = false;
+    {
+        std::lock_guard<std::mutex> lock(m_inputChangeMutex);
+        isSourceModule = m_isSourceLoop;
+    }
 
     /**
      * TODO: yzl
@@ -61,9 +116,8 @@ void Worker::WorkLoop() {
     constexpr size_t kMaxBatchSize = 4;
     constexpr std::chrono::milliseconds kBatchTimeout{100};
 
-    // TODO: get value from config.
-    bool isSyncInputs = false;
-    isSyncInputs = m_configPtr->GetValueOrDefault<bool>("syncInputs", isSyncInputs);
+    bool isSyncInputs = m_isSyncInputs;
+    m_inputWatermarks.assign(m_inputNames.size(), 0); // Inputs are wired before the worker starts.
 
     LOG_DEBUG("Worker for module '{}' is running. Is source module: {}. Is sync inputs: {}.", m_modulePtr->GetModuleName(),
               isSourceModule, isSyncInputs);
@@ -72,86 +126,490 @@ void Worker::WorkLoop() {
         assert(!isSourceModule);
         RunFusion(); // Run the fusion module.
     } else {
-        while (!m_stopFlag.load()) {
+        // A source has nothing to drain, it stops producing right away.
+        bool isDrained = isSourceModule;
+        while (!ShouldExit(isDrained)) {
+            ApplyPostedConfig();
+            if (m_hasInputChanges.load(std::memory_order_acquire)) {
+                ApplyInputChanges();
+            }
             if (isSourceModule) {
                 // Source Module Loop
                 Message emptyMessage;
                 m_modulePtr->Process(emptyMessage);
             } else {
                 // Sink or Filter/Transformer Module Loop
+                // Only an empty pull after the stop proves the inputs drained: upstream stopped before this worker.
+                const bool isStopping = m_stopFlag.load();
                 auto batchMessage = PullBatchMessage(kMaxBatchSize, kBatchTimeout);
-                m_modulePtr->ProcessBatch(batchMessage);
+                isDrained = isStopping && batchMessage.empty();
+                // Watermarks are taken out of the batch and delivered after the messages pulled with them.
+                bool isWatermarkAdvanced = false;
+                batchMessage.erase(std::remove_if(batchMessage.begin(), batchMessage.end(),
+                                                  [this, &isWatermarkAdvanced](const Message& message) {
+                                                      if (!message.HasType<Watermark>()) {
+                                                          return false;
+                                                      }
+                                                      isWatermarkAdvanced |= UpdateInputWatermark(message);
+                                                      return true;
+                                                  }),
+                                   batchMessage.end());
+                ProcessAndMeasure(batchMessage);
+                if (isWatermarkAdvanced) {
+                    DeliverWatermark();
+                }
             }
         }
+        // A drain ends the input, the module emits what nothing else would close any more.
+        if (isDrained && m_isDraining && !m_modulePtr->IsWarmingUp()) {
+            m_modulePtr->OnDrain();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_inputChangeMutex);
+        m_isLooping = false;
     }
+    ApplyInputChanges(); // Changes posted while the loop exited.
 
     LOG_DEBUG("Worker for module '{}' finished.", m_modulePtr->GetModuleName());
 }
 
 void Worker::RunFusion() {
-    // TODO: 如何优化呢，现在只有单Batch, 并且需要测试下内存占用.
+    // Inputs are named "src -> dst" and indexed by upstream module name, like the parts of a JoinedMessage.
+    const std::vector<std::string>& upstreamNames = m_inputNames;
+    auto getInputIndex = [&upstreamNames](const std::string& inputName) {
+        return static_cast<size_t>(std::lower_bound(upstreamNames.begin(), upstreamNames.end(), GetUpstreamName(inputName)) -
+                                   upstreamNames.begin());
+    };
+    std::vector<std::pair<size_t, ViewPtr<MessageQueue>>> queues;
+    for (auto& queuePair : m_inputQueueMap) {
+        queues.emplace_back(getInputIndex(queuePair.first), queuePair.second);
+    }
+    std::vector<std::pair<size_t, MessageRingReader*>> rings;
+    for (auto& ringPair : m_inputRingMap) {
+        rings.emplace_back(getInputIndex(ringPair.first), &ringPair.second);
+    }
 
-    // Key: message id, value: map of source module name and message.
-    std::unordered_map<int, std::unordered_map<std::string, Message>> messageCache; // Cache for messages.
-    const int expectedInputCount = m_inputQueueMap.size(); // Expected number of inputs.
+    // The part the joined message takes its meta from: the trigger of a latest_value join, else the first part.
+    size_t primaryIndex = 0;
 
-    // Define a timeout period.
-    constexpr std::chrono::minutes timeout{1};
-    uint64_t timeoutMs = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+    // Construct a pooled joined message derived from the primary part of the group.
+    // Inputs that did not deliver to a partial group have no part.
+    auto processGroup = [this, &upstreamNames, &primaryIndex](std::vector<Message>& completed) {
+        Message joinedMessage = MakePooledMessage<JoinedMessage>();
+        auto& joined = joinedMessage.Mut<JoinedMessage>(); // The only owner, no copy.
+        joined.Resize(upstreamNames.size());
+        size_t metaIndex = primaryIndex;
+        if (metaIndex >= completed.size() || !completed[metaIndex].HasData()) {
+            metaIndex = static_cast<size_t>(std::find_if(completed.begin(), completed.end(),
+                                                         [](const Message& part) { return part.HasData(); }) -
+                                            completed.begin());
+        }
+        if (metaIndex < completed.size()) {
+            joinedMessage.InheritMetaFrom(completed[metaIndex]);
+        }
+        for (size_t idx = 0; idx < completed.size(); ++idx) {
+            if (completed[idx].HasData()) {
+                joined.Set(static_cast<int>(idx), std::move(completed[idx]));
+            }
+        }
+        std::vector<Message> fusedMessageVec{std::move(joinedMessage)};
+        ProcessAndMeasure(fusedMessageVec); // process the fused message
+    };
 
-    while (!m_stopFlag.load()) {
-        uint64_t currentTimeMs =
-            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::unique_ptr<JoinOperator> join;
+    std::unique_ptr<TimeWindowJoin> windowJoin;
+    std::unique_ptr<LatestValueJoin> latestJoin;
+    switch (m_joinMode) {
+        case JoinMode::TIME_WINDOW: {
+            TimeWindowJoinOptions options;
+            options.tolerance = std::chrono::milliseconds(m_configPtr->GetValueOrDefault<int>("joinToleranceMs", 20));
+            options.window = std::chrono::milliseconds(m_configPtr->GetValueOrDefault<int>("joinWindowMs", 1000));
+            options.maxPending = static_cast<size_t>(std::max(m_configPtr->GetValueOrDefault<int>("joinMaxPending", 1024), 1));
+            windowJoin.reset(new TimeWindowJoin(upstreamNames.size(), options));
+            break;
+        }
+        case JoinMode::LATEST_VALUE: {
+            const auto primaryName = m_configPtr->GetValueOrDefault<std::string>("joinPrimary", "");
+            auto it = std::find(upstreamNames.begin(), upstreamNames.end(), primaryName);
+            if (it == upstreamNames.end()) {
+                it = std::min_element(upstreamNames.begin(), upstreamNames.end());
+                LOG_ERROR("Join primary '{}' of module '{}' is not an input, using '{}'.", primaryName,
+                          m_modulePtr->GetModuleName(), *it);
+            }
+            const auto maxStaleness = std::chrono::milliseconds(m_configPtr->GetValueOrDefault<int>("joinMaxStalenessMs", 0));
+            primaryIndex = static_cast<size_t>(it - upstreamNames.begin());
+            latestJoin.reset(new LatestValueJoin(upstreamNames.size(), primaryIndex, maxStaleness));
+            break;
+        }
+        default: join.reset(new JoinOperator(upstreamNames.size(), GetJoinOptions(upstreamNames))); break;
+    }
 
-        // collect message from all inputs
-        std::vector<Message> batchMessage;
-        for (auto& queuePair : m_inputQueueMap) {
-            auto& queue = queuePair.second;
+    std::vector<Message> completed;
+    bool isWatermarkAdvanced = false;
+    auto addToJoin = [&](size_t inputIndex, Message& message) {
+        if (message.HasType<Watermark>()) {
+            isWatermarkAdvanced |= UpdateInputWatermark(message);
+            return;
+        }
+        LOG_TRACE("Message with ID: {} received from input: {}", message.GetMetaData().messageId, upstreamNames[inputIndex]);
+        if (windowJoin) {
+            windowJoin->Add(inputIndex, std::move(message));
+            while (windowJoin->Poll(completed)) {
+                processGroup(completed);
+            }
+        } else if (latestJoin) {
+            if (latestJoin->Add(inputIndex, std::move(message), completed)) {
+                processGroup(completed);
+            }
+        } else if (join->Add(inputIndex, message.GetMetaData().correlationId, std::move(message), TimerService::Now(),
+                             completed)) {
+            processGroup(completed);
+        }
+    };
+
+    bool isDrained = false;
+    while (!ShouldExit(isDrained)) {
+        ApplyPostedConfig();
+        const bool isStopping = m_stopFlag.load();
+        const uint64_t seenSequence = m_inboxSignal.sequence();
 
+        // collect message from all inputs
+        bool received = false;
+        for (auto& queue : queues) {
+            Message message;
+            while (queue.second->tryPop(message)) {
+                received = true;
+                addToJoin(queue.first, message);
+            }
+        }
+        for (auto& ring : rings) {
             Message message;
-            if (queue->tryPop(message)) {
-                auto messageMeta = message.GetMetaData();
-                auto messageId = messageMeta.messageId;
-                auto& sourceModuleName = messageMeta.sourceName;
-                messageCache[messageId][sourceModuleName] = message;
-                LOG_DEBUG("Message with ID: {} received from source module: {}", messageId, sourceModuleName);
+            while (ring.second->tryPop(message)) {
+                received = true;
+                addToJoin(ring.first, message);
             }
         }
 
-        // check message is already in cache
-        for (auto it = messageCache.begin(); it != messageCache.end();) {
-            auto messageId = it->first;
-            auto& messageMap = it->second;
-
-            LOG_TRACE("Checking message with ID: {}", messageId);
-            LOG_TRACE("Number of inputs received: {}, Expected inputs: {}, module name: {}", messageMap.size(), expectedInputCount,
-                      m_modulePtr->GetModuleName());
-            if (messageMap.size() == expectedInputCount) {
-                // Construct a fused message and concat to batchMessage.
-                auto fusedMessage = MakeMessage(std::move(messageMap));
-                std::vector<Message> fusedMessageVec{fusedMessage};
-                m_modulePtr->ProcessBatch(fusedMessageVec); // process the fused message
-                it = messageCache.erase(it); // remove the message from cache
-            } else if (!messageMap.empty() && messageMap.begin()->second.GetMetaData().timestamp < (currentTimeMs - timeoutMs)) {
-                // timeout
-                LOG_WARN("Timeout for message with ID: {}, will be removed from cache", messageId);
-                it = messageCache.erase(it);
-            } else {
-                ++it;
+        // Only the correlation_id join has deadlines, the others drop old messages as new ones arrive.
+        auto nextDeadline = TimerService::Clock::time_point::max();
+        if (join) {
+            while (join->Expire(TimerService::Now(), completed)) {
+                processGroup(completed);
+            }
+            nextDeadline = join->GetNextDeadline();
+        }
+
+        // A message older than the watermark can no longer be matched by messages to come.
+        if (isWatermarkAdvanced) {
+            if (windowJoin) {
+                windowJoin->Advance(m_watermark);
+                while (windowJoin->Poll(completed)) {
+                    processGroup(completed); // Groups held for a successor that can no longer arrive.
+                }
             }
+            DeliverWatermark();
+            isWatermarkAdvanced = false;
+        }
+
+        isDrained = isStopping && !received;
+        if (!received) {
+            // Sleep until a message arrives or the next partial group expires.
+            WaitForInput(seenSequence, nextDeadline);
+        }
+    }
+
+    const auto& stats = join ? join->GetStats() : windowJoin ? windowJoin->GetStats() : latestJoin->GetStats();
+    const uint64_t droppedCount = stats.expiredCount + stats.unmatchedCount;
+    // The input ended: emit the groups the join still holds, as its policy would once their time is up.
+    const bool isFlushed = isDrained && m_isDraining && !m_modulePtr->IsWarmingUp();
+    if (isFlushed) {
+        if (windowJoin) {
+            windowJoin->Advance(std::numeric_limits<uint64_t>::max());
+            while (windowJoin->Poll(completed)) {
+                processGroup(completed);
+            }
+        } else if (join) {
+            while (join->Expire(TimerService::Clock::time_point::max(), completed)) {
+                processGroup(completed);
+            }
+        }
+        m_modulePtr->OnDrain();
+    }
+
+    // A held secondary of a latest_value join is a sample already paired, not a message lost.
+    const size_t pendingCount = join ? join->GetPendingCount()
+                                     : windowJoin ? windowJoin->GetPendingCount() : latestJoin->GetPendingCount();
+    const uint64_t flushDroppedCount = isFlushed ? stats.expiredCount + stats.unmatchedCount - droppedCount : 0;
+    m_heldDiscardedCount.store(static_cast<size_t>(flushDroppedCount) + (latestJoin ? 0 : pendingCount));
+    LOG_INFO("Join of module '{}' finished: {} joined ({} partial), {} expired, {} evicted, {} late, {} unmatched, {} pending.",
+             m_modulePtr->GetModuleName(), stats.joinedCount, stats.partialCount, stats.expiredCount, stats.evictedCount,
+             stats.lateCount, stats.unmatchedCount, pendingCount);
+}
+
+void Worker::AddInputName(const std::string& inputName) {
+    const std::string upstreamName = GetUpstreamName(inputName);
+    auto it = std::lower_bound(m_inputNames.begin(), m_inputNames.end(), upstreamName);
+    if (it != m_inputNames.end() && *it == upstreamName) {
+        return;
+    }
+    const size_t maxInputs = JoinedMessage::kMaxInputs;
+    if (m_isSyncInputs && m_inputNames.size() >= maxInputs) {
+        LOG_ERROR("Module '{}' joins more than {} inputs", m_modulePtr->GetModuleName(), maxInputs);
+        throw std::invalid_argument("Module " + m_modulePtr->GetModuleName() + " joins more than " +
+                                    std::to_string(maxInputs) + " inputs");
+    }
+    m_inputNames.insert(it, upstreamName);
+}
+
+JoinOptions Worker::GetJoinOptions(const std::vector<std::string>& upstreamNames) const {
+    JoinOptions options;
+    options.timeout = std::chrono::milliseconds(m_configPtr->GetValueOrDefault<int>("joinTimeoutMs", 60000));
+    options.maxPending = static_cast<size_t>(std::max(m_configPtr->GetValueOrDefault<int>("joinMaxPending", 1024), 1));
+    options.minInputs = static_cast<size_t>(std::max(m_configPtr->GetValueOrDefault<int>("joinMinInputs", 1), 1));
+
+    const auto policy = m_configPtr->GetValueOrDefault<std::string>("joinPolicy", "all");
+    if (policy == "k_of_n") {
+        options.policy = JoinPolicy::K_OF_N;
+    } else if (policy == "first_wins") {
+        options.policy = JoinPolicy::FIRST_WINS;
+    } else if (policy == "emit_partial_on_timeout") {
+        options.policy = JoinPolicy::EMIT_PARTIAL_ON_TIMEOUT;
+    } else if (policy != "all") {
+        LOG_WARN("Unknown join policy '{}', falling back to all.", policy);
+    }
+
+    // `joinWaitBudgetMs` is either one budget for all inputs, or a map of upstream module name to budget.
+    const auto defaultBudget = std::chrono::milliseconds(
+        m_configPtr->GetValueOrDefault<int>("joinWaitBudgetMs", static_cast<int>(options.timeout.count())));
+    const auto budgetMap = m_configPtr->GetValueOrDefault<std::map<std::string, Any>>("joinWaitBudgetMs", {});
+    for (const auto& upstreamName : upstreamNames) {
+        auto it = budgetMap.find(upstreamName);
+        const int* budget = it != budgetMap.end() ? it->second.get<int>() : nullptr;
+        options.inputBudgets.push_back(budget != nullptr ? std::chrono::milliseconds(*budget) : defaultBudget);
+    }
+    return options;
+}
+
+void Worker::WaitForInput(uint64_t seenSequence, TimerService::Clock::time_point deadline) {
+    // Checked after `seenSequence` was read: a `Stop()` after this point changes the sequence.
+    if (m_stopFlag.load()) {
+        return;
+    }
+
+    auto now = TimerService::Now();
+    if (deadline <= now) {
+        return;
+    }
+
+    // An earlier wake-up that has not fired yet covers this deadline too: the caller
+    // re-checks its deadline when woken and waits again.
+    const bool isArmed = m_wakeTimerId != TimerService::kInvalidTimerId && m_wakeDeadline > now;
+    if (deadline != TimerService::Clock::time_point::max() && (!isArmed || deadline < m_wakeDeadline)) {
+        auto& timerService = TimerService::Global();
+        if (isArmed) {
+            timerService.Cancel(m_wakeTimerId);
+        }
+        m_wakeDeadline = deadline;
+        m_wakeTimerId = timerService.Schedule(deadline, [this]() { m_inboxSignal.notify(); });
+    }
+
+    m_inboxSignal.wait(seenSequence);
+}
+
+void Worker::PostConfig(std::shared_ptr<const Config> config) {
+    std::atomic_store(&m_postedConfig, std::move(config));
+    m_hasPostedConfig.store(true, std::memory_order_release);
+    m_inboxSignal.notify(); // An idle worker picks it up when its wait ends.
+}
+
+void Worker::ApplyPostedConfig() {
+    if (!m_hasPostedConfig.load(std::memory_order_acquire)) {
+        return;
+    }
+    m_hasPostedConfig.store(false, std::memory_order_relaxed);
+    // A config posted meanwhile was either taken here, or sets the flag again.
+    auto config = std::atomic_exchange(&m_postedConfig, std::shared_ptr<const Config>());
+    if (!config) {
+        return;
+    }
+    const auto& moduleName = m_modulePtr->GetModuleName();
+    if (m_modulePtr->OnReconfigure(*config) == ErrorCode::SUCCESS) {
+        LOG_INFO("Module '{}' reconfigured.", moduleName);
+    } else {
+        LOG_ERROR("Module '{}' rejected its new config.", moduleName);
+    }
+}
+
+ErrorCode Worker::AttachQueue(const std::string& name, ViewPtr<MessageQueue> queue) { return ChangeInputs({name, queue}); }
+
+ErrorCode Worker::DetachQueue(const std::string& name) { return ChangeInputs({name, ViewPtr<MessageQueue>()}); }
+
+ErrorCode Worker::ChangeInputs(InputChange change) {
+    std::unique_lock<std::mutex> lock(m_inputChangeMutex);
+    const bool isAttached = m_inputQueueMap.find(change.name) != m_inputQueueMap.end();
+    if (isAttached == static_cast<bool>(change.queue)) {
+        LOG_ERROR("Module '{}' {} an input queue named '{}'.", m_modulePtr->GetModuleName(),
+                  isAttached ? "already has" : "has no", change.name);
+        return ErrorCode::FAILURE;
+    }
+    if (!m_isLooping) {
+        ApplyInputChange(change);
+        return ErrorCode::SUCCESS;
+    }
+    // A join is built for a fixed set of inputs, and a source loop never reads any.
+    if (m_isSyncInputs || m_isSourceLoop) {
+        LOG_ERROR("Module '{}' cannot change its inputs while it runs, it {}.", m_modulePtr->GetModuleName(),
+                  m_isSyncInputs ? "joins them" : "runs as a source");
+        return ErrorCode::FAILURE;
+    }
+
+    m_inputChanges.push_back(std::move(change));
+    m_hasInputChanges.store(true, std::memory_order_release);
+    m_inboxSignal.notify();
+    m_inputChangeCondition.wait(lock, [this]() { return m_inputChanges.empty(); });
+    return ErrorCode::SUCCESS;
+}
+
+void Worker::ApplyInputChanges() {
+    {
+        std::lock_guard<std::mutex> lock(m_inputChangeMutex);
+        for (const auto& change : m_inputChanges) {
+            ApplyInputChange(change);
+        }
+        m_inputChanges.clear();
+        m_hasInputChanges.store(false, std::memory_order_relaxed);
+    }
+    m_inputChangeCondition.notify_all();
+}
+
+void Worker::ApplyInputChange(const InputChange& change) {
+    const std::vector<std::string> previousNames = m_inputNames;
+    const std::vector<uint64_t> previousWatermarks = m_inputWatermarks;
+
+    if (change.queue) {
+        AddInputName(change.name);
+        change.queue->setSignal(&m_inboxSignal);
+        m_inputQueueMap[change.name] = change.queue;
+        LOG_DEBUG("Module '{}' attached input '{}'.", m_modulePtr->GetModuleName(), change.name);
+    } else {
+        m_inputQueueMap.erase(change.name);
+        // A multicast upstream also feeds a ring under the same name, which stays.
+        const std::string upstreamName = GetUpstreamName(change.name);
+        const bool isRingFed = std::any_of(m_inputRingMap.begin(), m_inputRingMap.end(), [&upstreamName](const auto& item) {
+            return GetUpstreamName(item.first) == upstreamName;
+        });
+        if (!isRingFed) {
+            m_inputNames.erase(std::remove(m_inputNames.begin(), m_inputNames.end(), upstreamName), m_inputNames.end());
         }
+        LOG_DEBUG("Module '{}' detached input '{}'.", m_modulePtr->GetModuleName(), change.name);
+    }
 
-#if 0
-        // Print the current state of the message cache.
-        LOG_TRACE("Message cache state:");
-        for (auto& pair : messageCache) {
-            LOG_TRACE("Message ID: {}", pair.first);
-            for (auto& innerPair : pair.second) {
-                LOG_TRACE("Source module: {}, Timestamp: {}", innerPair.first, innerPair.second.GetMetaData().timstamp);
+    // A new input holds the module's watermark back until it sends one.
+    m_inputWatermarks.assign(m_inputNames.size(), 0);
+    if (previousWatermarks.size() == previousNames.size()) {
+        for (size_t idx = 0; idx < m_inputNames.size(); ++idx) {
+            auto it = std::lower_bound(previousNames.begin(), previousNames.end(), m_inputNames[idx]);
+            if (it != previousNames.end() && *it == m_inputNames[idx]) {
+                m_inputWatermarks[idx] = previousWatermarks[it - previousNames.begin()];
             }
         }
-#endif
     }
+    m_modulePtr->SetInputNames(m_inputNames);
+}
+
+size_t Worker::GetPendingInputCount() const {
+    size_t pendingCount = 0;
+    for (const auto& item : m_inputQueueMap) {
+        pendingCount += item.second->getSize();
+    }
+    for (const auto& item : m_inputRingMap) {
+        pendingCount += item.second.getSize();
+    }
+    return pendingCount;
+}
+
+void Worker::BeginWarmUp(bool isSink) {
+    m_isWarmUpSink = isSink;
+    m_modulePtr->SetWarmingUp(true);
+}
+
+size_t Worker::EndWarmUp() {
+    size_t discardedCount = 0;
+    Message message;
+    for (auto& item : m_inputQueueMap) {
+        while (item.second->tryPop(message)) {
+            ++discardedCount;
+        }
+    }
+    for (auto& item : m_inputRingMap) {
+        while (item.second.tryPop(message)) {
+            ++discardedCount;
+        }
+    }
+
+    m_isWarmUpSink = false;
+    m_modulePtr->SetWarmingUp(false);
+    m_watermark = 0;
+    m_inputWatermarks.assign(m_inputNames.size(), 0);
+    m_loadStats.Reset();
+    m_isDraining = false;
+    m_drainDeadline = TimerService::Clock::time_point::min();
+    m_stopFlag.store(false);
+    return discardedCount;
+}
+
+bool Worker::ShouldExit(bool isDrained) const {
+    if (!m_stopFlag.load()) {
+        return false;
+    }
+    return !m_isDraining || isDrained || TimerService::Now() >= m_drainDeadline;
+}
+
+bool Worker::UpdateInputWatermark(const Message& watermark) {
+    const std::string& upstreamName = watermark.GetMetaData().sourceName;
+    auto it = std::lower_bound(m_inputNames.begin(), m_inputNames.end(), upstreamName);
+    if (it == m_inputNames.end() || *it != upstreamName || m_inputWatermarks.size() != m_inputNames.size()) {
+        LOG_WARN("Module '{}' received a watermark from '{}', which is not an input.", m_modulePtr->GetModuleName(),
+                 upstreamName);
+        return false;
+    }
+
+    uint64_t& inputWatermark = m_inputWatermarks[it - m_inputNames.begin()];
+    inputWatermark = std::max(inputWatermark, watermark.Borrow<Watermark>().eventTime);
+    const uint64_t watermarkTime = *std::min_element(m_inputWatermarks.begin(), m_inputWatermarks.end());
+    if (watermarkTime <= m_watermark) {
+        return false;
+    }
+    m_watermark = watermarkTime;
+    return true;
+}
+
+void Worker::DeliverWatermark() {
+    if (!m_isWarmUpSink) {
+        m_modulePtr->OnWatermark(m_watermark);
+    }
+    if (m_watermarkSink) {
+        m_watermarkSink(m_watermark);
+    }
+}
+
+void Worker::ProcessAndMeasure(std::vector<Message>& batchMessage) {
+    if (m_isWarmUpSink) {
+        batchMessage.clear(); // Warm-up samples never leave the pipeline.
+        return;
+    }
+    if (batchMessage.empty()) {
+        m_modulePtr->ProcessBatch(batchMessage);
+        return;
+    }
+
+    const size_t messageCount = batchMessage.size();
+    auto startTime = TimerService::Now();
+    m_modulePtr->ProcessBatch(batchMessage);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(TimerService::Now() - startTime);
+    m_loadStats.RecordLatency(static_cast<uint64_t>(elapsed.count()) / messageCount);
 }
 
 std::vector<Message> Worker::PullBatchMessage(size_t maxBatchSize, std::chrono::milliseconds batchTimeout) {
@@ -162,65 +620,25 @@ std::vector<Message> Worker::PullBatchMessage(size_t maxBatchSize, std::chrono::
     batchMessage.clear();
     batchMessage.reserve(maxBatchSize);
 
-    auto startTime = std::chrono::steady_clock::now();
+    const auto deadline = TimerService::Now() + batchTimeout;
 
-    // --- Phase 1: Greedy non-blocking pull ---
-    // Quickly drain any messages that are already waiting in the queues.
-    for (auto& item : m_inputQueueMap) {
-        auto& queue = item.second;
-        while (batchMessage.size() < maxBatchSize) {
-            Message message;
-            if (queue->tryPop(message)) {
-                batchMessage.push_back(std::move(message));
-            } else {
-                // This queue is empty, so move on to the next one.
-                break;
-            }
+    // Each pass greedily drains the messages that are already waiting in the queues and rings,
+    // then sleeps until any input is notified or the batch timeout expires.
+    while (true) {
+        const uint64_t seenSequence = m_inboxSignal.sequence();
+        for (auto& item : m_inputQueueMap) {
+            DrainInto(*item.second, batchMessage, maxBatchSize);
         }
-        if (batchMessage.size() >= maxBatchSize) {
-            return batchMessage; // Batch is full, no need to wait.
+        for (auto& item : m_inputRingMap) {
+            DrainInto(item.second, batchMessage, maxBatchSize);
         }
-    }
 
-    // --- Phase 2: Short-blocking polling loop ---
-    // If the batch is not yet full, enter a polling loop that waits efficiently.
-    while (!m_stopFlag.load()) {
-        // Check exit condition: batch is full.
-        if (batchMessage.size() >= maxBatchSize) {
+        // Check exit conditions: batch is full, the worker is stopping, its inputs or config changed, or total time has elapsed.
+        if (batchMessage.size() >= maxBatchSize || m_stopFlag.load() || m_hasInputChanges.load(std::memory_order_relaxed) ||
+            m_hasPostedConfig.load(std::memory_order_relaxed) || TimerService::Now() >= deadline) {
             break;
         }
-
-        // Check exit condition: total time has elapsed.
-        auto now = std::chrono::steady_clock::now();
-        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
-        if (elapsed >= batchTimeout) {
-            break;
-        }
-
-        // Iterate through all input queues and perform a short wait on each.
-        for (auto& item : m_inputQueueMap) {
-            auto& queue = item.second;
-            Message msg;
-            // Wait for a very short period (e.g., 1ms). This is the key to avoiding
-            // busy-waiting while remaining responsive to multiple inputs.
-            if (queue->waitAndPopFor(msg, std::chrono::milliseconds(1))) {
-                batchMessage.push_back(std::move(msg));
-                // Optimization: If a message was found, this queue might have more.
-                // Try to pop more in a non-blocking way to fill the batch faster.
-                while (batchMessage.size() < maxBatchSize) {
-                    Message message;
-                    if (queue->tryPop(message)) {
-                        batchMessage.push_back(std::move(message));
-                    } else {
-                        break; // The queue is now empty.
-                    }
-                }
-            }
-            // Check if the batch became full during the inner loop.
-            if (batchMessage.size() >= maxBatchSize) {
-                break;
-            }
-        }
+        WaitForInput(seenSequence, deadline);
     }
 
     return batchMessage;
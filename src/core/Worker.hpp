@@ -2,19 +2,36 @@
 #define NEXUSFLOW_WORKER_HPP
 
 #include "base/Define.hpp"
+#include "common/InboxSignal.hpp"
 #include "common/ViewPtr.hpp"
+#include "core/JoinOperator.hpp"
+#include "core/LoadStats.hpp"
+#include "core/TimerService.hpp"
 #include "nexusflow/ErrorCode.hpp"
 #include "nexusflow/Module.hpp"
 #include "utils/logging.hpp"
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace nexusflow { namespace core {
 
+// How a module with `syncInputs` groups the messages of its inputs, set by the module's `joinMode` config.
+enum class JoinMode {
+    CORRELATION_ID, // "correlation_id" (default, or "message_id"): messages with the same `MessageMeta::correlationId`.
+    TIME_WINDOW, // "time_window": messages whose `MessageMeta::eventTime` lie within `joinToleranceMs`.
+    LATEST_VALUE, // "latest_value": every message of `joinPrimary` with the latest message of the other inputs.
+};
+
 /**
  * @class Worker
  * @brief An internal worker class responsible for driving the execution of a single Module instance.
@@ -43,10 +60,22 @@ public:
     ErrorCode Start();
 
     /**
-     * @brief Signals the worker thread to stop and waits for it to join.
+     * @brief Signals the worker thread to stop, without waiting for it.
+     * @param drain Keep processing until the inputs are empty, or `drainDeadline` passes, before exiting.
+     *              Only useful once the upstream workers have stopped, so the inputs cannot refill.
+     * @param drainDeadline When a draining worker gives up on its inputs.
      * @return An ErrorCode indicating the result of the operation.
      */
-    ErrorCode Stop();
+    ErrorCode Stop(bool drain = false, TimerService::Clock::time_point drainDeadline = TimerService::Clock::time_point::min());
+
+    // The number of messages waiting in the input queues and rings, e.g. those a stopped worker left behind.
+    size_t GetPendingInputCount() const;
+
+    /**
+     * @brief The number of messages the join of a module with `syncInputs` held when its work loop last
+     * exited, and dropped: those a drain flushed out unmatched or expired, or all of them without a drain.
+     */
+    size_t GetHeldDiscardedCount() const { return m_heldDiscardedCount.load(); }
 
     // Setter and getter for the input queue map.
     void AddQueue(const std::string& name, ViewPtr<MessageQueue> queue) {
@@ -54,29 +83,155 @@ public:
             LOG_ERROR("Output queue with name {} already exists", name);
             throw std::invalid_argument("Output queue with name " + name + " already exists");
         }
+        AddInputName(name);
+        queue->setSignal(&m_inboxSignal); // The worker waits on all inputs at once.
         m_inputQueueMap[name] = std::move(queue);
     }
-    // ViewPtr<MessageQueue> GetQueue(const std::string& name) { return m_inputQueueMap[name]; }
-    // void RemoveQueue(const std::string& name) { m_inputQueueMap.erase(name); }
-    // void ClearQueues() { m_inputQueueMap.clear(); }
 
+    // Registers this worker as a consumer of an upstream module's multicast ring.
+    void AddRing(const std::string& name, ViewPtr<MessageRing> ring) {
+        if (m_inputRingMap.find(name) != m_inputRingMap.end()) {
+            LOG_ERROR("Input ring with name {} already exists", name);
+            throw std::invalid_argument("Input ring with name " + name + " already exists");
+        }
+        AddInputName(name);
+        m_inputRingMap[name] = ring->addConsumer(&m_inboxSignal);
+    }
+
+    /**
+     * @brief Adds an input queue, also while the worker runs; returns once the worker reads it.
+     * A running worker of a source or of a module with `syncInputs` cannot change its inputs.
+     * @return FAILURE if the input exists, or the running worker cannot change its inputs.
+     */
+    ErrorCode AttachQueue(const std::string& name, ViewPtr<MessageQueue> queue);
+
+    /**
+     * @brief Removes an input queue, also while the worker runs; returns once the worker no longer reads it.
+     * Messages left in the queue are not processed.
+     * @return FAILURE if there is no such input queue, or the running worker cannot change its inputs.
+     */
+    ErrorCode DetachQueue(const std::string& name);
+
+    // The names of the upstream modules, sorted; the index of a name is the input's index in a `JoinedMessage`.
+    const std::vector<std::string>& GetInputNames() const { return m_inputNames; }
+
+    bool IsSyncInputs() const { return m_isSyncInputs; }
+
+    // Whether the work loop runs and drives the module as a source, which never reads inputs. Thread-safe.
+    bool IsRunningAsSource() {
+        std::lock_guard<std::mutex> lock(m_inputChangeMutex);
+        return m_isLooping && m_isSourceLoop;
+    }
+
+    /**
+     * @brief Marks the work loop as running and decides whether it drives a source. Called before the
+     * loop's thread starts, so an input change made meanwhile is already checked against the running loop.
+     */
+    void BeginLoop();
+
+    // Runs the work loop, call `BeginLoop()` first.
     void WorkLoop();
 
+    /**
+     * @brief Hands a new config to the module, delivered to `Module::OnReconfigure()` between two batches.
+     * The snapshot is immutable and replaces any config not yet delivered. Thread-safe.
+     */
+    void PostConfig(std::shared_ptr<const Config> config);
+
+    // Sets where the watermarks are forwarded once the module handled them, i.e. to the module's outputs.
+    void SetWatermarkSink(std::function<void(uint64_t)> sink) { m_watermarkSink = std::move(sink); }
+
+    /**
+     * @brief Makes the next work loop part of a warm-up, see `Pipeline::WarmUp()`.
+     * @param isSink Discard the messages received instead of processing them, for a module without outputs.
+     */
+    void BeginWarmUp(bool isSink);
+
+    /**
+     * @brief Ends the warm-up once the work loop exited: discards what is left in the inputs, forgets the
+     * watermarks and the load figures, and lets the worker start again.
+     * @return The number of messages discarded.
+     */
+    size_t EndWarmUp();
+
+    // The load figures of this worker, read by the dispatchers of upstream modules.
+    ViewPtr<const LoadStats> GetLoadStats() const { return ViewPtr<const LoadStats>(&m_loadStats); }
+
 private:
+    /**
+     * @brief Runs the join loop of a module with `syncInputs` enabled.
+     * @details Messages from all inputs are grouped by `MessageMeta.correlationId` in a `JoinOperator`,
+     * by event time in a `TimeWindowJoin`, or sampled in a `LatestValueJoin`, depending on the
+     * join mode; every complete group is handed to the module as one message holding a
+     * `JoinedMessage`, indexed like `GetInputNames()`. While the inputs
+     * are empty the thread sleeps on the inbox signal until a message arrives or the next partial
+     * group expires.
+     */
     void RunFusion();
 
+    /**
+     * @brief Records the upstream module of an input named "src -> dst".
+     * @throws std::invalid_argument If a module with `syncInputs` gets more inputs than a `JoinedMessage` holds.
+     */
+    void AddInputName(const std::string& inputName);
+
+    // Reads the options of a `correlation_id` join from the config, `upstreamNames` are by input index.
+    JoinOptions GetJoinOptions(const std::vector<std::string>& upstreamNames) const;
+
+    /**
+     * @brief Sleeps until an input receives a message, the worker is stopped, or `deadline` passes.
+     * @details The deadline is armed on the shared `TimerService`, at most one wake-up per worker
+     * is pending at a time. `seenSequence` is the inbox sequence read before the inputs were drained.
+     */
+    void WaitForInput(uint64_t seenSequence, TimerService::Clock::time_point deadline);
+
+    /**
+     * @brief Whether the work loop should exit: as soon as the worker is stopped, or for a draining
+     * worker, once `isDrained` (its inputs were found empty after the stop) or the drain deadline passed.
+     */
+    bool ShouldExit(bool isDrained) const;
+
+    // Delivers the config posted last, if any. The common case costs one relaxed atomic load.
+    void ApplyPostedConfig();
+
+    // An input added or, with a null queue, removed by `AttachQueue()` or `DetachQueue()`.
+    struct InputChange {
+        std::string name;
+        ViewPtr<MessageQueue> queue;
+    };
+
+    // Applies the change right away if the work loop is not running, else posts it and waits until the loop applied it.
+    ErrorCode ChangeInputs(InputChange change);
+
+    // Applies the posted input changes. Called by the work loop between two batches.
+    void ApplyInputChanges();
+
+    // Changes the inputs and keeps the watermarks of the remaining ones. Call with `m_inputChangeMutex` held.
+    void ApplyInputChange(const InputChange& change);
+
+    /**
+     * @brief Records a watermark received on an input.
+     * @return true if the watermark of the module, the smallest of all inputs, advanced.
+     */
+    bool UpdateInputWatermark(const Message& watermark);
+
+    // Hands the watermark of the module to `Module::OnWatermark()`, then forwards it downstream.
+    void DeliverWatermark();
+
+    // Runs `ProcessBatch` and records the per-message processing time.
+    void ProcessAndMeasure(std::vector<Message>& batchMessage);
+
     /**
      * @brief Efficiently pulls a batch of messages from the input queue.
      * @details This function implements an efficient, two-phase strategy to gather messages
      * without causing busy-waiting on the CPU.
      *
      * 1.  **Greedy Phase:** It first performs a quick, non-blocking poll (`tryPop`) across all
-     *     input queues to immediately collect any readily available messages.
-     * 2.  **Blocking Poll Phase:** If the batch is not yet full, it enters a loop that
-     *     iterates through the input queues. For each queue, it performs a short-duration
-     *     blocking wait (`waitAndPopFor`). This allows the thread to sleep efficiently
-     *     if no messages are available, yielding the CPU, yet remaining highly responsive.
-     *     The loop continues until the batch is full or the timeout is reached.
+     *     input queues and rings to immediately collect any readily available messages.
+     * 2.  **Blocking Phase:** If the batch is not yet full, the thread sleeps on the inbox
+     *     signal, which every input notifies, and drains all inputs again when woken. The
+     *     batch closes when it is full or when the timeout, armed on the `TimerService`,
+     *     expires, and early when the worker stops or its inputs or config change.
      *
      * @param maxBatchSize The maximum number of messages to pull.
      * @param batchTimeout The maximum time to wait for messages to become available.
@@ -87,8 +242,39 @@ private:
     std::shared_ptr<Module> m_modulePtr = nullptr;
     ViewPtr<Config> m_configPtr;
     std::unordered_map<std::string, ViewPtr<MessageQueue>> m_inputQueueMap;
+    std::unordered_map<std::string, MessageRingReader> m_inputRingMap;
+    std::vector<std::string> m_inputNames; // Sorted. A multicast upstream feeds both a ring and a queue under one name.
 
     std::atomic<bool> m_stopFlag{false};
+    bool m_isDraining = false; // Written before `m_stopFlag` is set, read after it was.
+    TimerService::Clock::time_point m_drainDeadline = TimerService::Clock::time_point::min();
+    LoadStats m_loadStats;
+    std::atomic<size_t> m_heldDiscardedCount{0};
+    bool m_isWarmUpSink = false; // Discards its input, see `BeginWarmUp()`.
+
+    bool m_isSyncInputs = false;
+    JoinMode m_joinMode = JoinMode::CORRELATION_ID;
+    std::vector<uint64_t> m_inputWatermarks; // By input index. An input that sent none holds the module's watermark at 0.
+    uint64_t m_watermark = 0;
+    std::function<void(uint64_t)> m_watermarkSink;
+
+    // The config posted by `PostConfig()`, swapped in and out with the atomic shared_ptr functions.
+    std::shared_ptr<const Config> m_postedConfig;
+    std::atomic<bool> m_hasPostedConfig{false};
+
+    // Input changes posted to the running work loop; the loop only reads the input map.
+    std::mutex m_inputChangeMutex;
+    std::condition_variable m_inputChangeCondition; // Notified when the posted changes were applied.
+    std::vector<InputChange> m_inputChanges;
+    std::atomic<bool> m_hasInputChanges{false};
+    bool m_isLooping = false; // Guarded by `m_inputChangeMutex`.
+    bool m_isSourceLoop = false; // Guarded by `m_inputChangeMutex`.
+
+    InboxSignal m_inboxSignal; // Notified by the input queues and rings, by `Stop()` and by the wake-up timer.
+
+    // The pending wake-up on the TimerService. Only touched by the worker thread and the destructor.
+    TimerService::TimerId m_wakeTimerId = TimerService::kInvalidTimerId;
+    TimerService::Clock::time_point m_wakeDeadline = TimerService::Clock::time_point::min();
 };
 
 }} // namespace nexusflow::core
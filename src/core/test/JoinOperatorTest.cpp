@@ -0,0 +1,108 @@
+#include "../JoinOperator.hpp"
+#include <gtest/gtest.h>
+
+using namespace nexusflow;
+using nexusflow::core::JoinOperator;
+using nexusflow::core::JoinOptions;
+
+TEST(JoinOperatorTest, CompletesGroupsByCorrelationId) {
+    JoinOperator join(2, JoinOptions());
+    auto now = JoinOperator::Clock::now();
+    std::vector<Message> completed;
+
+    EXPECT_FALSE(join.Add(0, 1, MakeMessage(10), now, completed));
+    EXPECT_FALSE(join.Add(0, 2, MakeMessage(20), now, completed));
+    EXPECT_FALSE(join.Add(0, 1, MakeMessage(11), now, completed)); // Replaces the first part.
+    EXPECT_EQ(join.GetPendingCount(), 2u);
+
+    ASSERT_TRUE(join.Add(1, 1, MakeMessage(12), now, completed));
+    ASSERT_EQ(completed.size(), 2u);
+    EXPECT_EQ(completed[0].Borrow<int>(), 11);
+    EXPECT_EQ(completed[1].Borrow<int>(), 12);
+    EXPECT_EQ(join.GetPendingCount(), 1u);
+    EXPECT_EQ(join.GetStats().joinedCount, 1u);
+}
+
+TEST(JoinOperatorTest, ExpiresFromDeadlineHeap) {
+    JoinOptions options;
+    options.timeout = std::chrono::milliseconds(100);
+    JoinOperator join(2, options);
+    auto start = JoinOperator::Clock::now();
+    std::vector<Message> completed;
+
+    join.Add(0, 1, MakeMessage(1), start, completed);
+    join.Add(0, 2, MakeMessage(2), start + std::chrono::milliseconds(50), completed);
+    join.Add(1, 2, MakeMessage(2), start + std::chrono::milliseconds(60), completed); // Completes group 2.
+    EXPECT_EQ(join.GetNextDeadline(), start + std::chrono::milliseconds(100));
+
+    EXPECT_FALSE(join.Expire(start + std::chrono::milliseconds(99), completed));
+    EXPECT_EQ(join.GetPendingCount(), 1u);
+    EXPECT_FALSE(join.Expire(start + std::chrono::milliseconds(200), completed));
+    EXPECT_EQ(join.GetPendingCount(), 0u);
+    EXPECT_EQ(join.GetNextDeadline(), JoinOperator::Clock::time_point::max());
+    EXPECT_EQ(join.GetStats().expiredCount, 1u);
+}
+
+TEST(JoinOperatorTest, EvictsOldestWhenFull) {
+    JoinOptions options;
+    options.maxPending = 2;
+    JoinOperator join(2, options);
+    auto now = JoinOperator::Clock::now();
+    std::vector<Message> completed;
+
+    join.Add(0, 1, MakeMessage(1), now, completed);
+    join.Add(0, 2, MakeMessage(2), now + std::chrono::milliseconds(1), completed);
+    join.Add(0, 3, MakeMessage(3), now + std::chrono::milliseconds(2), completed);
+    EXPECT_EQ(join.GetPendingCount(), 2u);
+    EXPECT_EQ(join.GetStats().evictedCount, 1u);
+
+    // Group 1 was evicted, group 2 is still there.
+    EXPECT_FALSE(join.Add(1, 1, MakeMessage(1), now, completed));
+    EXPECT_EQ(join.GetStats().evictedCount, 2u);
+    EXPECT_TRUE(join.Add(1, 3, MakeMessage(3), now, completed));
+}
+
+TEST(JoinOperatorTest, KOfNHandsOverEarlyAndDropsStragglers) {
+    JoinOptions options;
+    options.policy = nexusflow::core::JoinPolicy::K_OF_N;
+    options.minInputs = 2;
+    JoinOperator join(3, options);
+    auto now = JoinOperator::Clock::now();
+    std::vector<Message> completed;
+
+    EXPECT_FALSE(join.Add(2, 1, MakeMessage(2), now, completed));
+    ASSERT_TRUE(join.Add(0, 1, MakeMessage(0), now, completed));
+    ASSERT_EQ(completed.size(), 3u);
+    EXPECT_EQ(completed[0].Borrow<int>(), 0);
+    EXPECT_FALSE(completed[1].HasData());
+    EXPECT_EQ(completed[2].Borrow<int>(), 2);
+
+    // The straggler does not start a new group, and the group is gone once every input delivered.
+    EXPECT_FALSE(join.Add(1, 1, MakeMessage(1), now, completed));
+    EXPECT_EQ(join.GetPendingCount(), 0u);
+    EXPECT_EQ(join.GetStats().partialCount, 1u);
+    EXPECT_EQ(join.GetStats().lateCount, 1u);
+}
+
+TEST(JoinOperatorTest, EmitsPartialWhenTheWaitBudgetsRunOut) {
+    JoinOptions options;
+    options.policy = nexusflow::core::JoinPolicy::EMIT_PARTIAL_ON_TIMEOUT;
+    options.inputBudgets = {std::chrono::milliseconds(100), std::chrono::milliseconds(30)};
+    JoinOperator join(2, options);
+    auto start = JoinOperator::Clock::now();
+    std::vector<Message> completed;
+
+    // Input 1 is missing: the group waits for its 30 ms budget only.
+    join.Add(0, 1, MakeMessage(10), start, completed);
+    EXPECT_EQ(join.GetNextDeadline(), start + std::chrono::milliseconds(30));
+    ASSERT_TRUE(join.Expire(start + std::chrono::milliseconds(30), completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 10);
+    EXPECT_FALSE(completed[1].HasData());
+    EXPECT_FALSE(join.Expire(start + std::chrono::milliseconds(30), completed));
+
+    // Input 0 is missing: the budget of 100 ms applies.
+    join.Add(1, 2, MakeMessage(20), start, completed);
+    EXPECT_EQ(join.GetNextDeadline(), start + std::chrono::milliseconds(100));
+    EXPECT_EQ(join.GetStats().partialCount, 1u);
+    EXPECT_EQ(join.GetStats().expiredCount, 0u);
+}
@@ -0,0 +1,48 @@
+#include "../LatestValueJoin.hpp"
+#include <gtest/gtest.h>
+
+using namespace nexusflow;
+using nexusflow::core::LatestValueJoin;
+
+namespace {
+Message MakeSample(int value, uint64_t eventTimeMs) {
+    auto msg = MakeMessage(value);
+    msg.MetaData().eventTime = eventTimeMs * 1000000;
+    return msg;
+}
+} // namespace
+
+TEST(LatestValueJoinTest, PrimaryTriggersWithHeldSecondaries) {
+    LatestValueJoin join(2, 0, std::chrono::nanoseconds(0));
+    std::vector<Message> completed;
+
+    // Nothing held yet: the primary is emitted alone.
+    ASSERT_TRUE(join.Add(0, MakeSample(1, 0), completed));
+    EXPECT_FALSE(completed[1].HasData());
+
+    EXPECT_FALSE(join.Add(1, MakeSample(100, 10), completed));
+    EXPECT_FALSE(join.Add(1, MakeSample(200, 20), completed));
+    EXPECT_EQ(join.GetPendingCount(), 1u);
+
+    // Every primary message is paired with the latest secondary one.
+    for (int frame = 2; frame < 5; ++frame) {
+        ASSERT_TRUE(join.Add(0, MakeSample(frame, 40 * frame), completed));
+        EXPECT_EQ(completed[0].Borrow<int>(), frame);
+        EXPECT_EQ(completed[1].Borrow<int>(), 200);
+    }
+    EXPECT_EQ(join.GetStats().joinedCount, 4u);
+    EXPECT_EQ(join.GetStats().partialCount, 1u);
+}
+
+TEST(LatestValueJoinTest, StaleSecondaryIsLeftOut) {
+    LatestValueJoin join(3, 1, std::chrono::milliseconds(100));
+    std::vector<Message> completed;
+
+    join.Add(0, MakeSample(0, 0), completed);
+    join.Add(2, MakeSample(2, 90), completed);
+
+    ASSERT_TRUE(join.Add(1, MakeSample(1, 150), completed));
+    EXPECT_FALSE(completed[0].HasData()); // 150 ms behind.
+    EXPECT_EQ(completed[1].Borrow<int>(), 1);
+    EXPECT_EQ(completed[2].Borrow<int>(), 2); // 60 ms behind.
+}
@@ -0,0 +1,141 @@
+#include "../TimeWindowJoin.hpp"
+#include <gtest/gtest.h>
+
+using namespace nexusflow;
+using nexusflow::core::TimeWindowJoin;
+using nexusflow::core::TimeWindowJoinOptions;
+
+namespace {
+Message MakeSample(int value, uint64_t eventTimeMs) {
+    auto msg = MakeMessage(value);
+    msg.MetaData().eventTime = eventTimeMs * 1000000;
+    return msg;
+}
+} // namespace
+
+TEST(TimeWindowJoinTest, PairsNearestWithinTolerance) {
+    TimeWindowJoin join(2, TimeWindowJoinOptions()); // 20 ms tolerance.
+    std::vector<Message> completed;
+
+    // Input 0 samples every 33 ms, input 1 every 30 ms starting at 30 ms.
+    join.Add(0, MakeSample(0, 0));
+    join.Add(0, MakeSample(33, 33));
+    join.Add(0, MakeSample(66, 66));
+    join.Add(1, MakeSample(30, 30));
+    join.Add(1, MakeSample(60, 60));
+    join.Add(1, MakeSample(90, 90));
+
+    // 0 has no partner within 20 ms; 30 pairs with 33, not 66; 60 pairs with 66, not 90.
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 33);
+    EXPECT_EQ(completed[1].Borrow<int>(), 30);
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 66);
+    EXPECT_EQ(completed[1].Borrow<int>(), 60);
+    EXPECT_FALSE(join.Poll(completed));
+
+    EXPECT_EQ(join.GetStats().joinedCount, 2u);
+    EXPECT_EQ(join.GetStats().unmatchedCount, 1u);
+    EXPECT_EQ(join.GetPendingCount(), 1u);
+}
+
+TEST(TimeWindowJoinTest, PrefersTheNearerSuccessor) {
+    TimeWindowJoin join(2, TimeWindowJoinOptions());
+    std::vector<Message> completed;
+
+    join.Add(0, MakeSample(100, 100));
+    join.Add(0, MakeSample(110, 110));
+    join.Add(1, MakeSample(112, 112));
+    join.Add(0, MakeSample(140, 140));
+
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 110);
+    EXPECT_EQ(join.GetStats().unmatchedCount, 1u);
+}
+
+TEST(TimeWindowJoinTest, MemoryIsBoundedByTheWindow) {
+    TimeWindowJoinOptions options;
+    options.window = std::chrono::milliseconds(100);
+    TimeWindowJoin join(2, options);
+    std::vector<Message> completed;
+
+    // Input 1 is silent, input 0 keeps producing.
+    for (uint64_t timeMs = 0; timeMs < 1000; timeMs += 10) {
+        join.Add(0, MakeSample(0, timeMs));
+        EXPECT_FALSE(join.Poll(completed));
+    }
+    EXPECT_LE(join.GetPendingCount(), 11u);
+    EXPECT_GT(join.GetStats().expiredCount, 80u);
+
+    // A late input still pairs with the nearest message left in the window.
+    join.Add(1, MakeSample(1, 988));
+    join.Add(1, MakeSample(1, 1020));
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].GetMetaData().eventTime, 990u * 1000000);
+}
+
+TEST(TimeWindowJoinTest, WatermarkDropsWhatCanNoLongerMatch) {
+    TimeWindowJoinOptions options;
+    options.tolerance = std::chrono::milliseconds(20);
+    TimeWindowJoin join(2, options);
+    std::vector<Message> completed;
+
+    join.Add(0, MakeSample(0, 100));
+    join.Add(0, MakeSample(0, 130));
+    join.Advance(125 * 1000000); // Input 1 will send nothing before 125 ms: 100 has no match within 20 ms.
+    EXPECT_EQ(join.GetPendingCount(), 1u);
+    EXPECT_EQ(join.GetStats().unmatchedCount, 1u);
+
+    join.Add(1, MakeSample(1, 135));
+    join.Add(0, MakeSample(0, 170));
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].GetMetaData().eventTime, 130u * 1000000);
+}
+
+TEST(TimeWindowJoinTest, WaitsForANearerMatchStillToCome) {
+    TimeWindowJoin join(2, TimeWindowJoinOptions()); // 20 ms tolerance.
+    std::vector<Message> completed;
+
+    // Polled after every message, as the worker does: 14 arrives after (0, 15) would already match.
+    join.Add(0, MakeSample(0, 0));
+    EXPECT_FALSE(join.Poll(completed));
+    join.Add(1, MakeSample(15, 15));
+    EXPECT_FALSE(join.Poll(completed));
+    join.Add(0, MakeSample(14, 14));
+    EXPECT_FALSE(join.Poll(completed));
+    join.Add(0, MakeSample(40, 40));
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 14);
+    EXPECT_EQ(completed[1].Borrow<int>(), 15);
+    EXPECT_EQ(join.GetStats().unmatchedCount, 1u);
+
+    // Without a successor, the watermark proves that none nearer can arrive.
+    join.Add(1, MakeSample(45, 45));
+    EXPECT_FALSE(join.Poll(completed));
+    join.Advance(49 * 1000000);
+    EXPECT_FALSE(join.Poll(completed));
+    join.Advance(50 * 1000000);
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 40);
+    EXPECT_EQ(completed[1].Borrow<int>(), 45);
+}
+
+TEST(TimeWindowJoinTest, WatermarkFarAheadReleasesTheHeldGroup) {
+    TimeWindowJoin join(2, TimeWindowJoinOptions()); // 20 ms tolerance.
+    std::vector<Message> completed;
+
+    join.Add(0, MakeSample(40, 40));
+    join.Add(1, MakeSample(45, 45));
+    EXPECT_FALSE(join.Poll(completed));
+
+    // Both messages fall behind the cutoff, but they match each other: the group is released, not dropped.
+    join.Advance(100 * 1000000);
+    EXPECT_EQ(join.GetPendingCount(), 2u);
+    ASSERT_TRUE(join.Poll(completed));
+    EXPECT_EQ(completed[0].Borrow<int>(), 40);
+    EXPECT_EQ(completed[1].Borrow<int>(), 45);
+    EXPECT_FALSE(join.Poll(completed));
+    EXPECT_EQ(join.GetStats().joinedCount, 1u);
+    EXPECT_EQ(join.GetStats().unmatchedCount, 0u);
+    EXPECT_EQ(join.GetPendingCount(), 0u);
+}
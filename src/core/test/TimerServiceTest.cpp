@@ -0,0 +1,49 @@
+#include "../TimerService.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+using nexusflow::core::TimerService;
+
+TEST(TimerServiceTest, FiresInDeadlineOrder) {
+    TimerService timerService;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    auto now = TimerService::Now();
+    timerService.Schedule(now + std::chrono::milliseconds(40), [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(2);
+        done.set_value();
+    });
+    timerService.Schedule(now + std::chrono::milliseconds(10), [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(1);
+    });
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_GE(TimerService::Now(), now + std::chrono::milliseconds(40));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(TimerServiceTest, CancelledTimerDoesNotFire) {
+    TimerService timerService;
+    std::atomic<int> calls{0};
+    std::promise<void> done;
+
+    auto now = TimerService::Now();
+    auto timerId = timerService.Schedule(now + std::chrono::milliseconds(10), [&]() { ++calls; });
+    timerService.Schedule(now + std::chrono::milliseconds(30), [&]() { done.set_value(); });
+    EXPECT_EQ(timerService.GetPendingCount(), 2u);
+    EXPECT_TRUE(timerService.Cancel(timerId));
+    EXPECT_FALSE(timerService.Cancel(timerId));
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    EXPECT_EQ(calls.load(), 0);
+    EXPECT_EQ(timerService.GetPendingCount(), 0u);
+}
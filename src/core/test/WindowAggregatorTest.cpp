@@ -0,0 +1,146 @@
+#include "../WindowAggregator.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+using namespace nexusflow;
+using nexusflow::core::WindowAggregator;
+using nexusflow::core::WindowMeasure;
+using nexusflow::core::WindowOptions;
+using nexusflow::core::WindowType;
+
+namespace {
+constexpr uint64_t kMs = 1000000;
+
+WindowOptions MakeOptions(WindowType type, uint64_t size, uint64_t slide = 0) {
+    WindowOptions options;
+    options.type = type;
+    options.size = size;
+    options.slide = slide;
+    return options;
+}
+} // namespace
+
+TEST(WindowAggregatorTest, TumblingTimeWindowsPerKey) {
+    WindowAggregator aggregator(MakeOptions(WindowType::TUMBLING, 100 * kMs));
+    std::vector<WindowAggregate> closed;
+
+    aggregator.Add(1, 2.0, 10 * kMs, closed);
+    aggregator.Add(2, 5.0, 20 * kMs, closed);
+    aggregator.Add(1, 4.0, 90 * kMs, closed);
+    EXPECT_TRUE(closed.empty());
+    EXPECT_EQ(aggregator.GetKeyCount(), 2u);
+
+    // The event time of any key closes the windows of all keys.
+    aggregator.Add(2, 1.0, 120 * kMs, closed);
+    ASSERT_EQ(closed.size(), 2u);
+    std::sort(closed.begin(), closed.end(), [](const WindowAggregate& a, const WindowAggregate& b) { return a.key < b.key; });
+    EXPECT_EQ(closed[0].key, 1u);
+    EXPECT_EQ(closed[0].count, 2u);
+    EXPECT_DOUBLE_EQ(closed[0].sum, 6.0);
+    EXPECT_DOUBLE_EQ(closed[0].Mean(), 3.0);
+    EXPECT_EQ(closed[0].windowStart, 0u);
+    EXPECT_EQ(closed[0].windowEnd, 100 * kMs);
+    EXPECT_EQ(closed[1].count, 1u);
+    EXPECT_EQ(aggregator.GetKeyCount(), 1u); // Key 1 has no open window left.
+
+    // A message for a closed window is dropped.
+    closed.clear();
+    aggregator.Add(1, 3.0, 50 * kMs, closed);
+    EXPECT_TRUE(closed.empty());
+    EXPECT_EQ(aggregator.GetStats().lateCount, 1u);
+}
+
+TEST(WindowAggregatorTest, SlidingTimeWindowRetractsPanes) {
+    WindowAggregator aggregator(MakeOptions(WindowType::SLIDING, 30 * kMs, 10 * kMs));
+    std::vector<WindowAggregate> closed;
+
+    aggregator.Add(0, 9.0, 5 * kMs, closed);
+    aggregator.Add(0, 1.0, 15 * kMs, closed);
+    aggregator.Add(0, 4.0, 25 * kMs, closed);
+    aggregator.Add(0, 2.0, 35 * kMs, closed);
+    ASSERT_EQ(closed.size(), 3u);
+    EXPECT_EQ(closed[2].windowStart, 0u);
+    EXPECT_EQ(closed[2].windowEnd, 30 * kMs);
+    EXPECT_EQ(closed[2].count, 3u);
+    EXPECT_DOUBLE_EQ(closed[2].max, 9.0);
+
+    // The pane holding 9 slid out of the window.
+    closed.clear();
+    aggregator.Advance(40 * kMs, closed);
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].windowStart, 10 * kMs);
+    EXPECT_EQ(closed[0].count, 3u);
+    EXPECT_DOUBLE_EQ(closed[0].sum, 7.0);
+    EXPECT_DOUBLE_EQ(closed[0].min, 1.0);
+    EXPECT_DOUBLE_EQ(closed[0].max, 4.0);
+
+    // An idle key emits its shrinking windows, then holds nothing.
+    closed.clear();
+    aggregator.Advance(1000 * kMs, closed);
+    EXPECT_EQ(closed.size(), 2u);
+    EXPECT_EQ(aggregator.GetKeyCount(), 0u);
+}
+
+TEST(WindowAggregatorTest, SessionClosesAfterGap) {
+    WindowOptions options = MakeOptions(WindowType::SESSION, 1);
+    options.gap = 50 * kMs;
+    WindowAggregator aggregator(options);
+    std::vector<WindowAggregate> closed;
+
+    aggregator.Add(0, 1.0, 0, closed);
+    aggregator.Add(0, 1.0, 40 * kMs, closed);
+    aggregator.Add(0, 1.0, 80 * kMs, closed);
+    EXPECT_TRUE(closed.empty());
+
+    aggregator.Add(0, 1.0, 200 * kMs, closed);
+    ASSERT_EQ(closed.size(), 1u);
+    EXPECT_EQ(closed[0].count, 3u);
+    EXPECT_EQ(closed[0].windowStart, 0u);
+    EXPECT_EQ(closed[0].windowEnd, 80 * kMs);
+}
+
+TEST(WindowAggregatorTest, SlidingCountWindow) {
+    WindowOptions options = MakeOptions(WindowType::SLIDING, 4, 2);
+    options.measure = WindowMeasure::COUNT;
+    WindowAggregator aggregator(options);
+    std::vector<WindowAggregate> closed;
+
+    for (int value = 1; value <= 6; ++value) {
+        aggregator.Add(0, value, value * kMs, closed);
+    }
+    ASSERT_EQ(closed.size(), 3u);
+    EXPECT_EQ(closed[0].count, 2u);
+    EXPECT_EQ(closed[1].count, 4u);
+    EXPECT_DOUBLE_EQ(closed[2].sum, 3.0 + 4.0 + 5.0 + 6.0);
+    EXPECT_DOUBLE_EQ(closed[2].min, 3.0);
+    EXPECT_EQ(closed[2].windowStart, 3 * kMs);
+    EXPECT_EQ(closed[2].windowEnd, 6 * kMs);
+}
+
+TEST(WindowAggregatorTest, FlushClosesTheOpenWindows) {
+    WindowAggregator timeAggregator(MakeOptions(WindowType::TUMBLING, 100 * kMs));
+    std::vector<WindowAggregate> closed;
+    timeAggregator.Add(1, 2.0, 10 * kMs, closed);
+    timeAggregator.Add(2, 5.0, 20 * kMs, closed);
+    timeAggregator.Flush(closed);
+    EXPECT_EQ(closed.size(), 2u);
+    EXPECT_EQ(closed[0].windowEnd, 100 * kMs);
+    EXPECT_EQ(timeAggregator.GetKeyCount(), 0u);
+
+    // A count window closes with the messages it has; a full one was emitted already.
+    WindowOptions options = MakeOptions(WindowType::SLIDING, 4, 2);
+    options.measure = WindowMeasure::COUNT;
+    WindowAggregator countAggregator(options);
+    closed.clear();
+    for (int value = 1; value <= 7; ++value) {
+        countAggregator.Add(0, value, value * kMs, closed);
+    }
+    ASSERT_EQ(closed.size(), 3u);
+    countAggregator.Flush(closed);
+    ASSERT_EQ(closed.size(), 4u);
+    EXPECT_EQ(closed[3].count, 3u);
+    EXPECT_DOUBLE_EQ(closed[3].sum, 5.0 + 6.0 + 7.0);
+    countAggregator.Flush(closed);
+    EXPECT_EQ(closed.size(), 4u);
+}
@@ -0,0 +1,66 @@
+#include "ConsistentHashRing.hpp"
+
+#include <algorithm>
+
+namespace nexusflow { namespace dispatcher {
+
+namespace {
+
+// The splitmix64 finalizer, spreads sequential keys such as stream ids over the ring.
+inline uint64_t MixHash(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// 64-bit FNV-1a.
+inline uint64_t HashString(const std::string& text) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char ch : text) {
+        hash ^= ch;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+ConsistentHashRing::ConsistentHashRing(int virtualNodes) : m_virtualNodes(std::max(virtualNodes, 1)) {}
+
+void ConsistentHashRing::AddMember(const std::string& name, int memberIndex) {
+    RemoveMember(name);
+
+    const uint64_t nameHash = HashString(name);
+    for (int replica = 0; replica < m_virtualNodes; ++replica) {
+        m_points.push_back({MixHash(nameHash + static_cast<uint64_t>(replica)), memberIndex, name});
+    }
+    std::sort(m_points.begin(), m_points.end(), [](const Point& lhs, const Point& rhs) {
+        // Ties are broken by name, so the ring does not depend on the insertion order.
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash : lhs.name < rhs.name;
+    });
+    ++m_memberCount;
+}
+
+void ConsistentHashRing::RemoveMember(const std::string& name) {
+    auto newEnd = std::remove_if(m_points.begin(), m_points.end(), [&name](const Point& point) { return point.name == name; });
+    if (newEnd != m_points.end()) {
+        m_points.erase(newEnd, m_points.end());
+        --m_memberCount;
+    }
+}
+
+int ConsistentHashRing::Lookup(uint64_t key) const {
+    if (m_points.empty()) {
+        return -1;
+    }
+
+    const uint64_t hash = MixHash(key);
+    auto it = std::lower_bound(m_points.begin(), m_points.end(), hash,
+                               [](const Point& point, uint64_t value) { return point.hash < value; });
+    if (it == m_points.end()) {
+        it = m_points.begin(); // Wrap around.
+    }
+    return it->memberIndex;
+}
+
+}} // namespace nexusflow::dispatcher
@@ -0,0 +1,64 @@
+#ifndef NEXUSFLOW_CONSISTENT_HASH_RING_HPP
+#define NEXUSFLOW_CONSISTENT_HASH_RING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nexusflow { namespace dispatcher {
+
+/**
+ * @class ConsistentHashRing
+ * @brief Maps 64-bit keys onto a set of named members with consistent hashing.
+ *
+ * Every member is placed on the ring at several pseudo-random points ("virtual nodes")
+ * derived from its name, and a key belongs to the first member point at or after the
+ * key's hash. Because the points depend on the name only, adding or removing a member
+ * moves roughly 1/N of the keys, all others keep their member.
+ *
+ * Lookups are a binary search over a sorted vector. The ring is not thread-safe; a dispatcher
+ * changes a copy of it and publishes the copy, see `Dispatcher::RemoveSubscriber()`.
+ */
+class ConsistentHashRing {
+public:
+    static constexpr int kDefaultVirtualNodes = 128;
+
+    explicit ConsistentHashRing(int virtualNodes = kDefaultVirtualNodes);
+
+    /**
+     * @brief Adds a member to the ring.
+     * @param name The stable name the member's points are derived from.
+     * @param memberIndex The value `Lookup()` returns for keys owned by this member.
+     */
+    void AddMember(const std::string& name, int memberIndex);
+
+    /**
+     * @brief Removes a member and all its points from the ring.
+     */
+    void RemoveMember(const std::string& name);
+
+    /**
+     * @brief Finds the member owning a key.
+     * @return The member's index, or -1 if the ring is empty.
+     */
+    int Lookup(uint64_t key) const;
+
+    size_t GetMemberCount() const { return m_memberCount; }
+
+private:
+    struct Point {
+        uint64_t hash;
+        int memberIndex;
+        std::string name;
+    };
+
+    int m_virtualNodes;
+    size_t m_memberCount = 0;
+    std::vector<Point> m_points; // Sorted by hash.
+};
+
+}} // namespace nexusflow::dispatcher
+
+#endif // NEXUSFLOW_CONSISTENT_HASH_RING_HPP
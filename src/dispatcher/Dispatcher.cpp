@@ -1,25 +1,260 @@
 #include "Dispatcher.hpp"
 #include "nexusflow/Config.hpp"
 
+#include <algorithm>
+
 namespace nexusflow { namespace dispatcher {
 
-Dispatcher::Dispatcher(const ViewPtr<Config>& configView) { m_configView = configView; };
+namespace {
+// Separator of the legacy queue names, "src -> dst".
+constexpr char kQueueNameSeparator[] = " -> ";
+// Messages partitioned before warning that the partition key was 0 for all of them.
+constexpr size_t kZeroKeyWarningCount = 64;
+} // namespace
+
+Dispatcher::Dispatcher(const ViewPtr<Config>& configView) {
+    m_routing.store(new Routing());
+    m_configView = configView;
+    if (!m_configView) {
+        return;
+    }
+
+    const auto outputMode = m_configView->GetValueOrDefault<std::string>("outputMode", "broadcast");
+    if (outputMode == "partition") {
+        const auto keyName = m_configView->GetValueOrDefault<std::string>("partitionKey", "streamId");
+        m_keyExtractor = PartitionKeyRegistry::GetInstance().Find(keyName);
+        if (!m_keyExtractor) {
+            LOG_ERROR("Unknown partition key '{}'", keyName);
+            throw std::invalid_argument("Unknown partition key " + keyName);
+        }
+        m_outputMode = OutputMode::PARTITION;
+    } else if (outputMode == "round_robin") {
+        m_outputMode = OutputMode::ROUND_ROBIN;
+    } else if (outputMode == "least_loaded") {
+        m_outputMode = OutputMode::LEAST_LOADED;
+        const auto loadMetric = m_configView->GetValueOrDefault<std::string>("loadMetric", "queue_depth");
+        if (loadMetric == "latency") {
+            m_loadMetric = LoadMetric::LATENCY;
+        } else if (loadMetric != "queue_depth") {
+            LOG_WARN("Unknown load metric '{}', falling back to queue_depth.", loadMetric);
+        }
+    } else if (outputMode == "multicast") {
+        m_outputMode = OutputMode::MULTICAST;
+    } else if (outputMode != "broadcast") {
+        LOG_WARN("Unknown output mode '{}', falling back to broadcast.", outputMode);
+    }
+};
+
+Dispatcher::~Dispatcher() { delete m_routing.load(); }
+
+void Dispatcher::AddSubscriber(const std::string& name, ViewPtr<MessageQueue> queue, ViewPtr<const core::LoadStats> loadStats,
+                               std::shared_ptr<EdgeFilter> filter, bool isQueueFed) {
+    std::lock_guard<std::mutex> lock(m_routingMutex);
+    const Routing& current = *m_routing.load();
+    if (Resolve(current, name).IsValid()) {
+        LOG_ERROR("Output queue with name {} already exists", name);
+        throw std::invalid_argument("Output queue with name " + name + " already exists");
+    }
+
+    std::unique_ptr<Routing> routing(new Routing(current));
+    // A name added again takes back the slot it was removed from, so reconnecting does not grow the routing.
+    size_t index = 0;
+    while (index < routing->subscribers.size() && routing->subscribers[index].name != name) {
+        ++index;
+    }
+    if (index == routing->subscribers.size()) {
+        routing->subscribers.emplace_back();
+    }
+    // A filter decides per connection, so filtered outputs are not fed through the ring.
+    isQueueFed = isQueueFed || filter != nullptr;
+    if (isQueueFed) {
+        routing->queueFedIndices.push_back(index);
+    }
+    routing->subscribers[index] = {name, queue, loadStats, std::move(filter), isQueueFed};
+    routing->partitionRing.AddMember(name, static_cast<int>(index));
+    PublishRouting(std::move(routing));
+}
+
+bool Dispatcher::RemoveSubscriber(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_routingMutex);
+    const Routing& current = *m_routing.load();
+    const OutputPort port = Resolve(current, name);
+    if (!port.IsValid()) {
+        return false;
+    }
+
+    std::unique_ptr<Routing> routing(new Routing(current));
+    const size_t index = static_cast<size_t>(port.m_index);
+    routing->subscribers[index].queue.reset(); // The slot stays, so the other ports keep their index.
+    routing->queueFedIndices.erase(std::remove(routing->queueFedIndices.begin(), routing->queueFedIndices.end(), index),
+                                   routing->queueFedIndices.end());
+    routing->partitionRing.RemoveMember(routing->subscribers[index].name);
+    PublishRouting(std::move(routing));
+    return true;
+}
+
+void Dispatcher::PublishRouting(std::unique_ptr<Routing> routing) {
+    const Routing* previous = m_routing.exchange(routing.release(), std::memory_order_seq_cst);
+    m_epochs.synchronize(); // Sends that read the previous routing have finished.
+    delete previous;
+}
+
+bool Dispatcher::IsQueueFed(const OutputPort& port) const {
+    auto guard = m_epochs.enter();
+    const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+    return port.m_index >= 0 && static_cast<size_t>(port.m_index) < routing.subscribers.size() &&
+           routing.subscribers[port.m_index].isQueueFed;
+}
+
+void Dispatcher::Broadcast(const Routing& routing, const Message& message) {
+    for (const auto& subscriber : routing.subscribers) {
+        Push(subscriber, message);
+    }
+}
+
+void Dispatcher::DispatchWatermark(const Message& watermark) {
+    auto guard = m_epochs.enter();
+    const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+    if (m_outputMode == OutputMode::MULTICAST && m_multicastRing) {
+        m_multicastRing->tryPublish(watermark);
+        for (size_t index : routing.queueFedIndices) {
+            routing.subscribers[index].queue->tryPush(watermark);
+        }
+        return;
+    }
+    for (const auto& subscriber : routing.subscribers) {
+        if (subscriber.queue) {
+            subscriber.queue->tryPush(watermark);
+        }
+    }
+}
 
-Dispatcher::~Dispatcher() = default;
+void Dispatcher::Multicast(const Routing& routing, const Message& message) {
+    if (m_multicastRing) {
+        m_multicastRing->tryPublish(message);
+    }
+    for (size_t index : routing.queueFedIndices) {
+        Push(routing.subscribers[index], message);
+    }
+}
+
+void Dispatcher::Partition(const Routing& routing, const Message& message) {
+    const uint64_t key = m_keyExtractor(message);
+    if (key != 0) {
+        m_hasNonZeroKey.store(true, std::memory_order_relaxed);
+    } else if (!m_hasNonZeroKey.load(std::memory_order_relaxed) &&
+               m_zeroKeyCount.fetch_add(1, std::memory_order_relaxed) + 1 == kZeroKeyWarningCount) {
+        LOG_WARN("The partition key was 0 for the first {} messages, so they all went to one output. "
+                 "Sources must set the key, e.g. `MessageMeta::streamId`.",
+                 kZeroKeyWarningCount);
+    }
+
+    int index = routing.partitionRing.Lookup(key);
+    // The key's owner filters alone: handing a rejected message to another output would split the key.
+    if (index >= 0 && Push(routing.subscribers[index], message) == PushResult::FILTERED) {
+        m_filteredDropCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Dispatcher::RoundRobin(const Routing& routing, const Message& message) {
+    const size_t first = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    if (PushToNext(routing, message, first, nullptr) == PushResult::FILTERED) {
+        m_filteredDropCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+Dispatcher::PushResult Dispatcher::PushToNext(const Routing& routing, const Message& message, size_t first,
+                                              const Subscriber* skipped) {
+    const size_t count = routing.subscribers.size();
+    PushResult result = PushResult::NOT_DELIVERED;
+    // A full queue means a busy consumer, and a rejecting filter an output that does not want the message:
+    // hand it to the next one instead of dropping it.
+    for (size_t attempt = 0; attempt < count; ++attempt) {
+        const auto& subscriber = routing.subscribers[(first + attempt) % count];
+        if (&subscriber == skipped) {
+            continue;
+        }
+        switch (Push(subscriber, message)) {
+            case PushResult::DELIVERED: return PushResult::DELIVERED;
+            case PushResult::FILTERED: result = PushResult::FILTERED; break;
+            case PushResult::NOT_DELIVERED: break;
+        }
+    }
+    return result;
+}
+
+void Dispatcher::SendToLeastLoaded(const Routing& routing, const Message& message) {
+    const Subscriber* target = nullptr;
+    uint64_t targetLoad = 0;
+    // Start the scan at a rotating offset, so equally loaded outputs share the messages.
+    const size_t count = routing.subscribers.size();
+    const size_t first = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+    for (size_t offset = 0; offset < count; ++offset) {
+        const auto& subscriber = routing.subscribers[(first + offset) % count];
+        if (!subscriber.queue) {
+            continue;
+        }
+        uint64_t load = GetLoad(subscriber);
+        if (target == nullptr || load < targetLoad) {
+            target = &subscriber;
+            targetLoad = load;
+        }
+    }
+    if (target != nullptr && Push(*target, message) == PushResult::FILTERED &&
+        PushToNext(routing, message, first, target) == PushResult::FILTERED) {
+        m_filteredDropCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Dispatcher::GetLoad(const Subscriber& subscriber) const {
+    const uint64_t depth = subscriber.queue->getSize();
+    if (m_loadMetric == LoadMetric::LATENCY && subscriber.loadStats) {
+        // The expected time until a new message is processed. Consumers without samples yet count as 1ns
+        // per message, so they are tried first.
+        const uint64_t latencyNs = std::max<uint64_t>(subscriber.loadStats->GetLatencyNs(), 1);
+        return (depth + 1) * latencyNs;
+    }
+    return depth;
+}
+
+void Dispatcher::SendTo(const std::string& outputName, const Message& msg) { SendTo(Resolve(outputName), msg); }
+
+OutputPort Dispatcher::Resolve(const Routing& routing, const std::string& outputName) {
+    std::string name = outputName;
+    auto sepPos = name.find(kQueueNameSeparator);
+    if (sepPos != std::string::npos) {
+        name = name.substr(sepPos + sizeof(kQueueNameSeparator) - 1);
+    }
+
+    for (size_t idx = 0; idx < routing.subscribers.size(); ++idx) {
+        if (routing.subscribers[idx].name == name && routing.subscribers[idx].queue) {
+            return OutputPort(static_cast<int>(idx));
+        }
+    }
+    return {};
+}
 
-void Dispatcher::Broadcast(const Message& message) {
-    for (auto& pair : m_subscriberMap) {
-        auto& subscriber = pair.second;
-        subscriber->tryPush(message);
+std::vector<std::string> Dispatcher::GetSubscriberNames() const {
+    auto guard = m_epochs.enter();
+    const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+    std::vector<std::string> names;
+    names.reserve(routing.subscribers.size());
+    for (const auto& subscriber : routing.subscribers) {
+        if (subscriber.queue) {
+            names.push_back(subscriber.name);
+        }
     }
+    return names;
 }
 
-void Dispatcher::SendTo(const std::string& outputName, const Message& msg) {
-    auto it = m_subscriberMap.find(outputName);
-    if (it != m_subscriberMap.end()) {
-        auto& subscriber = it->second;
-        subscriber->tryPush(msg);
+void Dispatcher::ResetFilters() {
+    auto guard = m_epochs.enter();
+    for (const auto& subscriber : m_routing.load(std::memory_order_seq_cst)->subscribers) {
+        if (subscriber.filter) {
+            subscriber.filter->Reset();
+        }
     }
+    m_filteredDropCount.store(0, std::memory_order_relaxed);
 }
 
-}} // namespace nexusflow::dispatcher
\ No newline at end of file
+}} // namespace nexusflow::dispatcher
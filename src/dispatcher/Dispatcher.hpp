@@ -2,19 +2,43 @@
 #define NEXUSFLOW_DISPATCHER_HPP
 
 #include "base/Define.hpp"
+#include "common/EpochDomain.hpp"
 #include "common/ViewPtr.hpp"
+#include "core/LoadStats.hpp"
+#include "dispatcher/ConsistentHashRing.hpp"
+#include "dispatcher/EdgeFilter.hpp"
+#include "dispatcher/TapSet.hpp"
 #include "nexusflow/Config.hpp"
 #include "nexusflow/Message.hpp"
+#include "nexusflow/Module.hpp"
+#include "nexusflow/PartitionKey.hpp"
 #include "utils/logging.hpp"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 namespace nexusflow { namespace dispatcher {
 
+// How `Dispatch()` distributes a module's messages, set by the module's `outputMode` config.
+enum class OutputMode {
+    BROADCAST, // "broadcast" (default): every output receives every message.
+    PARTITION, // "partition": each message goes to one output, chosen by hashing its partition key.
+    ROUND_ROBIN, // "round_robin": each message goes to the next output in turn.
+    LEAST_LOADED, // "least_loaded": each message goes to the output with the least work queued, see `LoadMetric`.
+    MULTICAST, // "multicast": like broadcast, but every message is written once into a ring all outputs read.
+};
+
+// How `least_loaded` measures the load of an output, set by the module's `loadMetric` config.
+enum class LoadMetric {
+    QUEUE_DEPTH, // "queue_depth" (default): the number of messages waiting in the output queue.
+    LATENCY, // "latency": the queued messages weighted by the consumer's recent processing time per message.
+};
+
 /**
  * @class Dispatcher
  * @brief An internal helper class responsible for dispatching messages to downstream queues.
@@ -23,48 +47,226 @@ namespace nexusflow { namespace dispatcher {
  * of pre-configured output queues. It holds non-owning "view" pointers to the queues,
  * which are owned and managed by the Pipeline.
  *
+ * Subscribers are kept in a flat vector; an `OutputPort` is simply an index into it.
+ * In `partition` mode a consistent hash ring over the subscriber names picks the output,
+ * so the mapping of keys to downstream instances stays stable when instances come and go.
+ *
+ * Subscribers can be added and removed while the module runs. The vector and the ring form
+ * an immutable `Routing`, replaced copy-on-write and reclaimed through an `EpochDomain`: every
+ * send reads the routing inside an epoch guard, and `RemoveSubscriber()` returns only once no
+ * send can still reach the removed queue. A removed subscriber keeps its slot, so the ports
+ * resolved before stay valid; sending through its port does nothing until a subscriber of the
+ * same name is added again, which takes the slot back.
+ *
+ * An output's filter only decides what that output receives. In `round_robin` and `least_loaded`
+ * mode a message the chosen output's filter rejects goes to the next output that accepts it. In
+ * `partition` mode it is dropped instead, as another output must not see the key, and counted in
+ * `GetFilteredDropCount()`.
+ *
  * This is an implementation detail of the framework and is not part of the public API.
  */
 class Dispatcher {
 public:
     Dispatcher(const ViewPtr<Config>& configView);
 
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+
     ~Dispatcher();
 
+    /**
+     * @brief Distributes a message to the output queues according to the output mode.
+     * @param msg The message to dispatch.
+     */
+    void Dispatch(const Message& msg) {
+        if (m_taps.HasTaps()) {
+            m_taps.Publish(msg);
+        }
+        auto guard = m_epochs.enter();
+        const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+        switch (m_outputMode) {
+            case OutputMode::PARTITION: Partition(routing, msg); break;
+            case OutputMode::ROUND_ROBIN: RoundRobin(routing, msg); break;
+            case OutputMode::LEAST_LOADED: SendToLeastLoaded(routing, msg); break;
+            case OutputMode::MULTICAST: Multicast(routing, msg); break;
+            case OutputMode::BROADCAST:
+            default: Broadcast(routing, msg); break;
+        }
+    }
+
+    /**
+     * @brief Sends a watermark to every output, whatever the output mode and filters.
+     * In multicast mode it goes through the ring, behind the messages published before it.
+     * A watermark that finds a queue full is dropped, the next one supersedes it.
+     */
+    void DispatchWatermark(const Message& watermark);
+
     /**
      * @brief Broadcasts a message to all configured output queues.
-     * @details To optimize performance, this method copies the message for the
-     * first N-1 queues and moves the original message into the last queue.
      * @param msg The message to broadcast.
      */
-    void Broadcast(const Message& msg);
+    void Broadcast(const Message& msg) {
+        auto guard = m_epochs.enter();
+        Broadcast(*m_routing.load(std::memory_order_seq_cst), msg);
+    }
 
     /**
      * @brief Sends a message to a specific output queue.
-     * @param outputName The name of the output queue to send the message to.
+     * @param outputName The name of the downstream module to send the message to.
      * @param msg The message to send.
-     * @throws std::invalid_argument If the outputName is not found in the output queue map.
      */
     void SendTo(const std::string& outputName, const Message& msg);
 
+    /**
+     * @brief Sends a message through a pre-resolved output port.
+     * @param port The port returned by `Resolve()`, invalid ports are ignored.
+     * @param msg The message to send.
+     */
+    void SendTo(const OutputPort& port, const Message& msg) {
+        auto guard = m_epochs.enter();
+        const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+        if (port.m_index >= 0 && static_cast<size_t>(port.m_index) < routing.subscribers.size()) {
+            if (m_taps.HasTaps()) {
+                m_taps.Publish(msg);
+            }
+            Push(routing.subscribers[port.m_index], msg);
+        }
+    }
+
+    /**
+     * @brief Resolves an output name into a port.
+     * @param outputName The name of the downstream module. The legacy queue name format
+     *                   "src -> dst" is accepted as well.
+     * @return The port, or an invalid port if no subscriber has that name.
+     */
+    OutputPort Resolve(const std::string& outputName) const {
+        auto guard = m_epochs.enter();
+        return Resolve(*m_routing.load(std::memory_order_seq_cst), outputName);
+    }
+
     /**
      * @brief Adds a new output queue to the dispatcher.
-     * @param name The name of the output queue.
+     * @param name The name of the downstream module the queue leads to.
      * @param queue The output queue to add.
+     * @param loadStats The load figures of the downstream worker, used by `loadMetric: latency`.
+     * @param filter The connection's filter, or nullptr to enqueue every message.
+     * @param isQueueFed Feed the output through its queue even in `multicast` mode, as filtered outputs
+     *                   are. For outputs added while the module runs, since a ring takes no new readers then.
+     * @throws std::invalid_argument If a subscriber with the same name already exists.
      */
-    void AddSubscriber(const std::string& name, ViewPtr<MessageQueue> queue) {
-        if (m_subscriberMap.find(name) != m_subscriberMap.end()) {
-            LOG_ERROR("Output queue with name {} already exists", name);
-            throw std::invalid_argument("Output queue with name " + name + " already exists");
+    void AddSubscriber(const std::string& name, ViewPtr<MessageQueue> queue, ViewPtr<const core::LoadStats> loadStats = {},
+                       std::shared_ptr<EdgeFilter> filter = nullptr, bool isQueueFed = false);
+
+    /**
+     * @brief Removes an output queue. Returns once no message can be enqueued on it anymore,
+     * even by a send that started before the call. Thread-safe with the sends.
+     * @return false if no subscriber has that name.
+     */
+    bool RemoveSubscriber(const std::string& name);
+
+    // Gets the filter of an output, null if the output does not filter.
+    ViewPtr<const EdgeFilter> GetFilter(const OutputPort& port) const {
+        auto guard = m_epochs.enter();
+        const Routing& routing = *m_routing.load(std::memory_order_seq_cst);
+        if (port.m_index < 0 || static_cast<size_t>(port.m_index) >= routing.subscribers.size()) {
+            return {};
         }
-        m_subscriberMap[name] = queue;
+        // Removed subscribers keep their filter until their slot is reused, so the pointer outlives the routing.
+        return ViewPtr<const EdgeFilter>(routing.subscribers[port.m_index].filter.get());
     }
 
+    // Whether the output is fed through its queue in `multicast` mode, rather than through the ring.
+    bool IsQueueFed(const OutputPort& port) const;
+
+    std::vector<std::string> GetSubscriberNames() const;
+
+    // Resets the filters of all outputs, see `EdgeFilter::Reset()`, and the filtered drop count.
+    // Call while the module sends nothing.
+    void ResetFilters();
+
+    // Messages a single-output mode sent nowhere because a filter rejected them, rather than a full queue.
+    uint64_t GetFilteredDropCount() const { return m_filteredDropCount.load(std::memory_order_relaxed); }
+
+    OutputMode GetOutputMode() const { return m_outputMode; }
+
+    // The taps observing every message this dispatcher sends, attached at runtime.
+    TapSet& GetTaps() { return m_taps; }
+
+    // Sets the ring `multicast` mode publishes to. Filtered outputs and targeted sends still use the output queues.
+    void SetMulticastRing(ViewPtr<MessageRing> ring) { m_multicastRing = ring; }
+
 private:
+    struct Subscriber {
+        std::string name;
+        ViewPtr<MessageQueue> queue; // Null once the subscriber was removed.
+        ViewPtr<const core::LoadStats> loadStats;
+        std::shared_ptr<EdgeFilter> filter;
+        bool isQueueFed;
+    };
+
+    // The subscribers and what is derived from them, immutable once published.
+    struct Routing {
+        std::vector<Subscriber> subscribers;
+        std::vector<size_t> queueFedIndices; // The outputs `multicast` mode feeds through their queue.
+        ConsistentHashRing partitionRing;
+    };
+
+    enum class PushResult { DELIVERED, FILTERED, NOT_DELIVERED };
+
+    // Enqueues a message on one output unless the output's filter rejects it.
+    // NOT_DELIVERED means the queue is full, or the subscriber was removed.
+    static PushResult Push(const Subscriber& subscriber, const Message& msg) {
+        if (!subscriber.queue) {
+            return PushResult::NOT_DELIVERED;
+        }
+        if (subscriber.filter && !subscriber.filter->Accept(msg)) {
+            return PushResult::FILTERED;
+        }
+        return subscriber.queue->tryPush(msg) ? PushResult::DELIVERED : PushResult::NOT_DELIVERED;
+    }
+
+    static OutputPort Resolve(const Routing& routing, const std::string& outputName);
+
+    void Broadcast(const Routing& routing, const Message& msg);
+
+    // Publishes a message to the multicast ring once, and enqueues it on the queue-fed outputs.
+    void Multicast(const Routing& routing, const Message& msg);
+
+    // Sends a message to the single output owning its partition key.
+    void Partition(const Routing& routing, const Message& msg);
+
+    // Sends a message to the next output in turn, skipping outputs whose queue is full or whose filter rejects it.
+    void RoundRobin(const Routing& routing, const Message& msg);
+
+    // Sends a message to the output with the lowest `GetLoad()`, or on to the next outputs if its filter rejects it.
+    void SendToLeastLoaded(const Routing& routing, const Message& msg);
+
+    // Tries the outputs in turn from `first`, leaving out `skipped`, until one takes the message.
+    // Returns FILTERED if none took it and a filter rejected it.
+    static PushResult PushToNext(const Routing& routing, const Message& msg, size_t first, const Subscriber* skipped);
+
+    uint64_t GetLoad(const Subscriber& subscriber) const;
+
+    // Publishes a new routing and frees the previous one once no send reads it. Call with `m_routingMutex` held.
+    void PublishRouting(std::unique_ptr<Routing> routing);
+
     ViewPtr<Config> m_configView;
-    std::unordered_map<std::string, ViewPtr<MessageQueue>> m_subscriberMap;
+
+    std::mutex m_routingMutex; // Serializes the changes of the routing.
+    std::atomic<const Routing*> m_routing{nullptr}; // Owned.
+    mutable EpochDomain m_epochs;
+
+    OutputMode m_outputMode = OutputMode::BROADCAST;
+    PartitionKeyExtractor m_keyExtractor;
+    std::atomic<bool> m_hasNonZeroKey{false};
+    std::atomic<size_t> m_zeroKeyCount{0}; // Partitioned messages with key 0, counted until a nonzero key shows up.
+    LoadMetric m_loadMetric = LoadMetric::QUEUE_DEPTH;
+    std::atomic<size_t> m_nextIndex{0};
+    std::atomic<uint64_t> m_filteredDropCount{0};
+    ViewPtr<MessageRing> m_multicastRing;
+    TapSet m_taps;
 };
 
 }} // namespace nexusflow::dispatcher
 
-#endif // NEXUSFLOW_DISPATCHER_HPP
\ No newline at end of file
+#endif // NEXUSFLOW_DISPATCHER_HPP
@@ -0,0 +1,78 @@
+#include "EdgeFilter.hpp"
+#include "utils/logging.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace nexusflow { namespace dispatcher {
+
+namespace {
+
+// YAML scalars such as `5` are parsed as int, `2.5` as double; accept both.
+double GetNumberOrDefault(const Config& config, const std::string& key, double defaultValue) {
+    const auto& configMap = config.GetConfigMap();
+    auto it = configMap.find(key);
+    if (it == configMap.end()) {
+        return defaultValue;
+    }
+    if (it->second.hasValue<int>()) {
+        return *it->second.get<int>();
+    }
+    return config.GetValueOrDefault<double>(key, defaultValue);
+}
+
+} // namespace
+
+std::unique_ptr<EdgeFilter> EdgeFilter::Create(const Config& edgeConfig) {
+    std::unique_ptr<EdgeFilter> filter(new EdgeFilter());
+    bool filters = false;
+
+    const auto predicateName = edgeConfig.GetValueOrDefault<std::string>("predicate", "");
+    if (!predicateName.empty()) {
+        filter->m_predicate = MessagePredicateRegistry::GetInstance().Find(predicateName);
+        if (!filter->m_predicate) {
+            LOG_ERROR("Unknown message predicate '{}'", predicateName);
+            throw std::invalid_argument("Unknown message predicate " + predicateName);
+        }
+        filters = true;
+    }
+
+    const double everyN = GetNumberOrDefault(edgeConfig, "sampleEveryN", 1);
+    if (everyN > 1) {
+        filter->m_sampleEveryN = static_cast<uint64_t>(everyN);
+        filters = true;
+    }
+
+    const double rateLimitHz = GetNumberOrDefault(edgeConfig, "rateLimitHz", 0);
+    if (rateLimitHz > 0) {
+        filter->m_minInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rateLimitHz));
+        filters = true;
+    }
+
+    return filters ? std::move(filter) : nullptr;
+}
+
+bool EdgeFilter::Accept(const Message& msg) {
+    if (m_predicate && !m_predicate(msg)) {
+        return Reject();
+    }
+
+    if (m_sampleEveryN > 1 && (m_sampleCounter++ % m_sampleEveryN) != 0) {
+        return Reject();
+    }
+
+    if (m_minInterval.count() > 0) {
+        auto now = std::chrono::steady_clock::now();
+        if (m_hasAccepted && now - m_lastAccepted < m_minInterval) {
+            return Reject();
+        }
+        m_lastAccepted = now;
+        m_hasAccepted = true;
+    }
+
+    m_acceptedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+}} // namespace nexusflow::dispatcher
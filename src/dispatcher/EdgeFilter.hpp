@@ -0,0 +1,72 @@
+#ifndef NEXUSFLOW_EDGE_FILTER_HPP
+#define NEXUSFLOW_EDGE_FILTER_HPP
+
+#include "nexusflow/Config.hpp"
+#include "nexusflow/Message.hpp"
+#include "nexusflow/MessagePredicate.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace nexusflow { namespace dispatcher {
+
+/**
+ * @class EdgeFilter
+ * @brief Decides which messages enter one connection's queue.
+ *
+ * Built from a connection's `filter` config, with any combination of:
+ *   - `predicate`: the name of a registered `MessagePredicate` a message must satisfy.
+ *   - `sampleEveryN`: keep one of every N messages that passed the predicate.
+ *   - `rateLimitHz`: keep at most this many messages per second.
+ * The checks run in this order inside the upstream Dispatcher, so a rejected message is
+ * never enqueued. Accepted and rejected messages are counted.
+ *
+ * `Accept()` must only be called from one thread at a time, the counters can be read from any.
+ */
+class EdgeFilter {
+public:
+    /**
+     * @brief Creates a filter from a connection's config.
+     * @return The filter, or nullptr if the config does not filter anything.
+     * @throws std::invalid_argument If the config names an unknown predicate.
+     */
+    static std::unique_ptr<EdgeFilter> Create(const Config& edgeConfig);
+
+    bool Accept(const Message& msg);
+
+    uint64_t GetAcceptedCount() const { return m_acceptedCount.load(std::memory_order_relaxed); }
+
+    uint64_t GetRejectedCount() const { return m_rejectedCount.load(std::memory_order_relaxed); }
+
+    // Resets the counters and the sampling and rate limit state, as if no message had been seen. Like `Accept()`.
+    void Reset() {
+        m_sampleCounter = 0;
+        m_hasAccepted = false;
+        m_acceptedCount.store(0, std::memory_order_relaxed);
+        m_rejectedCount.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    EdgeFilter() = default;
+
+    bool Reject() {
+        m_rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    MessagePredicate m_predicate;
+    uint64_t m_sampleEveryN = 1;
+    uint64_t m_sampleCounter = 0;
+    std::chrono::steady_clock::duration m_minInterval{0};
+    std::chrono::steady_clock::time_point m_lastAccepted;
+    bool m_hasAccepted = false;
+
+    std::atomic<uint64_t> m_acceptedCount{0};
+    std::atomic<uint64_t> m_rejectedCount{0};
+};
+
+}} // namespace nexusflow::dispatcher
+
+#endif // NEXUSFLOW_EDGE_FILTER_HPP
@@ -0,0 +1,21 @@
+#include "nexusflow/MessagePredicate.hpp"
+
+namespace nexusflow {
+
+MessagePredicateRegistry& MessagePredicateRegistry::GetInstance() {
+    static MessagePredicateRegistry instance;
+    return instance;
+}
+
+void MessagePredicateRegistry::Register(const std::string& predicateName, MessagePredicate predicate) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_predicates[predicateName] = std::move(predicate);
+}
+
+MessagePredicate MessagePredicateRegistry::Find(const std::string& predicateName) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_predicates.find(predicateName);
+    return it != m_predicates.end() ? it->second : MessagePredicate();
+}
+
+} // namespace nexusflow
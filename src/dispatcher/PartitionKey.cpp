@@ -0,0 +1,27 @@
+#include "nexusflow/PartitionKey.hpp"
+
+namespace nexusflow {
+
+PartitionKeyRegistry& PartitionKeyRegistry::GetInstance() {
+    static PartitionKeyRegistry instance;
+    return instance;
+}
+
+PartitionKeyRegistry::PartitionKeyRegistry() {
+    m_extractors["streamId"] = [](const Message& msg) { return msg.GetMetaData().streamId; };
+    m_extractors["messageId"] = [](const Message& msg) { return msg.GetMetaData().messageId; };
+    m_extractors["correlationId"] = [](const Message& msg) { return msg.GetMetaData().correlationId; };
+}
+
+void PartitionKeyRegistry::Register(const std::string& keyName, PartitionKeyExtractor extractor) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_extractors[keyName] = std::move(extractor);
+}
+
+PartitionKeyExtractor PartitionKeyRegistry::Find(const std::string& keyName) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_extractors.find(keyName);
+    return it != m_extractors.end() ? it->second : PartitionKeyExtractor();
+}
+
+} // namespace nexusflow
@@ -0,0 +1,42 @@
+#include "base/Define.hpp"
+#include <nexusflow/Tap.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
+namespace nexusflow {
+
+class TapBuffer::Impl {
+public:
+    explicit Impl(size_t capacity) : queue(static_cast<int>(std::min<size_t>(std::max<size_t>(capacity, 1), INT_MAX))) {}
+
+    MessageQueue queue;
+    std::atomic<uint64_t> droppedCount{0};
+};
+
+std::shared_ptr<TapBuffer> TapBuffer::Create(size_t capacity) { return std::shared_ptr<TapBuffer>(new TapBuffer(capacity)); }
+
+TapBuffer::TapBuffer(size_t capacity) : m_pImpl(std::make_unique<Impl>(capacity)) {}
+
+TapBuffer::~TapBuffer() = default;
+
+bool TapBuffer::TryPush(const Message& msg) {
+    if (m_pImpl->queue.tryPush(msg)) {
+        return true;
+    }
+    m_pImpl->droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool TapBuffer::TryPop(Message& msg) { return m_pImpl->queue.tryPop(msg); }
+
+bool TapBuffer::WaitAndPopFor(Message& msg, std::chrono::milliseconds timeout) {
+    return m_pImpl->queue.waitAndPopFor(msg, timeout);
+}
+
+size_t TapBuffer::GetSize() const { return m_pImpl->queue.getSize(); }
+
+uint64_t TapBuffer::GetDroppedCount() const { return m_pImpl->droppedCount.load(std::memory_order_relaxed); }
+
+} // namespace nexusflow
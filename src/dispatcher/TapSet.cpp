@@ -0,0 +1,45 @@
+#include "TapSet.hpp"
+
+#include <algorithm>
+
+namespace nexusflow { namespace dispatcher {
+
+TapSet::~TapSet() { delete m_taps.load(); }
+
+void TapSet::Publish(const Message& msg) {
+    auto guard = m_epochs.enter();
+    for (const auto& tap : *m_taps.load(std::memory_order_seq_cst)) {
+        if (tap.seenCount->fetch_add(1, std::memory_order_relaxed) % tap.sampleEveryN == 0) {
+            tap.buffer->TryPush(msg); // Drops when full, a tap never slows down the module.
+        }
+    }
+}
+
+void TapSet::Add(TapId tapId, std::shared_ptr<TapBuffer> buffer, uint32_t sampleEveryN) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<TapList> taps(new TapList(*m_taps.load()));
+    taps->push_back({tapId, std::move(buffer), std::max<uint32_t>(sampleEveryN, 1), std::make_shared<std::atomic<uint64_t>>(0)});
+    PublishTaps(std::move(taps));
+    m_hasTaps.store(true, std::memory_order_relaxed);
+}
+
+bool TapSet::Remove(TapId tapId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unique_ptr<TapList> taps(new TapList(*m_taps.load()));
+    auto newEnd = std::remove_if(taps->begin(), taps->end(), [tapId](const Tap& tap) { return tap.id == tapId; });
+    if (newEnd == taps->end()) {
+        return false;
+    }
+    taps->erase(newEnd, taps->end());
+    m_hasTaps.store(!taps->empty(), std::memory_order_relaxed);
+    PublishTaps(std::move(taps));
+    return true;
+}
+
+void TapSet::PublishTaps(std::unique_ptr<TapList> taps) {
+    const TapList* previous = m_taps.exchange(taps.release(), std::memory_order_seq_cst);
+    m_epochs.synchronize(); // Publishes that read the previous list have finished.
+    delete previous;
+}
+
+}} // namespace nexusflow::dispatcher
@@ -0,0 +1,74 @@
+#ifndef NEXUSFLOW_TAP_SET_HPP
+#define NEXUSFLOW_TAP_SET_HPP
+
+#include "common/EpochDomain.hpp"
+#include "nexusflow/Message.hpp"
+#include "nexusflow/Tap.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nexusflow { namespace dispatcher {
+
+/**
+ * @class TapSet
+ * @brief The taps attached to one module's output.
+ *
+ * Taps are attached and detached while the pipeline runs. The dispatcher checks
+ * `HasTaps()` on every message, which is a single relaxed atomic load; only when taps
+ * are attached does it call `Publish()`, which reads the immutable tap list inside an
+ * `EpochDomain` guard and offers the message to each tap without ever blocking. The list
+ * is replaced copy-on-write, and `Remove()` returns once no publish can reach the tap.
+ */
+class TapSet {
+public:
+    TapSet() = default;
+
+    TapSet(const TapSet&) = delete;
+    TapSet& operator=(const TapSet&) = delete;
+
+    ~TapSet();
+
+    inline bool HasTaps() const { return m_hasTaps.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Offers a message to every attached tap, honoring their sampling rates.
+     */
+    void Publish(const Message& msg);
+
+    /**
+     * @brief Attaches a tap.
+     * @param sampleEveryN The tap receives one of every N messages.
+     */
+    void Add(TapId tapId, std::shared_ptr<TapBuffer> buffer, uint32_t sampleEveryN);
+
+    /**
+     * @brief Detaches a tap. Returns once no publish can offer a message to it any more.
+     * @return true if the tap was attached.
+     */
+    bool Remove(TapId tapId);
+
+private:
+    struct Tap {
+        TapId id;
+        std::shared_ptr<TapBuffer> buffer;
+        uint32_t sampleEveryN;
+        std::shared_ptr<std::atomic<uint64_t>> seenCount; // Shared by the snapshots of the list.
+    };
+    using TapList = std::vector<Tap>;
+
+    // Publishes a new tap list and frees the previous one once no publish reads it. Call with `m_mutex` held.
+    void PublishTaps(std::unique_ptr<TapList> taps);
+
+    std::mutex m_mutex; // Serializes the changes of the tap list.
+    std::atomic<const TapList*> m_taps{new TapList()}; // Owned.
+    EpochDomain m_epochs;
+    std::atomic<bool> m_hasTaps{false};
+};
+
+}} // namespace nexusflow::dispatcher
+
+#endif // NEXUSFLOW_TAP_SET_HPP
@@ -0,0 +1,57 @@
+#include "../ConsistentHashRing.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using nexusflow::dispatcher::ConsistentHashRing;
+
+TEST(ConsistentHashRingTest, SpreadsKeysOverMembers) {
+    ConsistentHashRing ring;
+    EXPECT_EQ(ring.Lookup(42), -1);
+
+    ring.AddMember("Tracker0", 0);
+    ring.AddMember("Tracker1", 1);
+    ring.AddMember("Tracker2", 2);
+    EXPECT_EQ(ring.GetMemberCount(), 3u);
+
+    std::vector<int> counts(3, 0);
+    for (uint64_t key = 0; key < 3000; ++key) {
+        int index = ring.Lookup(key);
+        ASSERT_GE(index, 0);
+        ASSERT_LT(index, 3);
+        ++counts[index];
+        EXPECT_EQ(ring.Lookup(key), index); // Deterministic.
+    }
+    for (int count : counts) {
+        EXPECT_GT(count, 600);
+    }
+}
+
+TEST(ConsistentHashRingTest, AddingMemberOnlyMovesKeysToIt) {
+    ConsistentHashRing ring;
+    ring.AddMember("Tracker0", 0);
+    ring.AddMember("Tracker1", 1);
+
+    std::vector<int> before;
+    for (uint64_t key = 0; key < 1000; ++key) {
+        before.push_back(ring.Lookup(key));
+    }
+
+    ring.AddMember("Tracker2", 2);
+    int moved = 0;
+    for (uint64_t key = 0; key < 1000; ++key) {
+        int index = ring.Lookup(key);
+        if (index != before[key]) {
+            EXPECT_EQ(index, 2);
+            ++moved;
+        }
+    }
+    EXPECT_GT(moved, 0);
+    EXPECT_LT(moved, 600);
+
+    // Removing the member restores the original mapping.
+    ring.RemoveMember("Tracker2");
+    for (uint64_t key = 0; key < 1000; ++key) {
+        EXPECT_EQ(ring.Lookup(key), before[key]);
+    }
+}
@@ -0,0 +1,219 @@
+#include "../Dispatcher.hpp"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace nexusflow;
+using nexusflow::dispatcher::Dispatcher;
+
+namespace {
+class DispatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_dispatcher.AddSubscriber("left", ViewPtr<MessageQueue>(&m_leftQueue));
+        m_dispatcher.AddSubscriber("right", ViewPtr<MessageQueue>(&m_rightQueue));
+    }
+
+    Config m_config;
+    MessageQueue m_leftQueue{4};
+    MessageQueue m_rightQueue{4};
+    Dispatcher m_dispatcher{ViewPtr<Config>(&m_config)};
+};
+} // namespace
+
+TEST_F(DispatcherTest, ResolveOutputPorts) {
+    OutputPort left = m_dispatcher.Resolve("left");
+    OutputPort right = m_dispatcher.Resolve("right");
+    ASSERT_TRUE(left.IsValid());
+    ASSERT_TRUE(right.IsValid());
+    EXPECT_NE(left.GetIndex(), right.GetIndex());
+
+    // The legacy queue name resolves to the same port.
+    EXPECT_EQ(m_dispatcher.Resolve("source -> right").GetIndex(), right.GetIndex());
+    EXPECT_FALSE(m_dispatcher.Resolve("missing").IsValid());
+    EXPECT_FALSE(OutputPort().IsValid());
+
+    EXPECT_EQ(m_dispatcher.GetSubscriberNames(), (std::vector<std::string>{"left", "right"}));
+    EXPECT_THROW(m_dispatcher.AddSubscriber("left", ViewPtr<MessageQueue>(&m_leftQueue)), std::invalid_argument);
+}
+
+TEST_F(DispatcherTest, SendThroughPort) {
+    OutputPort right = m_dispatcher.Resolve("right");
+    m_dispatcher.SendTo(right, MakeMessage(1));
+    m_dispatcher.SendTo("right", MakeMessage(2));
+    m_dispatcher.SendTo(OutputPort(), MakeMessage(3)); // Ignored.
+
+    EXPECT_EQ(m_leftQueue.getSize(), 0u);
+    ASSERT_EQ(m_rightQueue.getSize(), 2u);
+
+    m_dispatcher.Broadcast(MakeMessage(4));
+    EXPECT_EQ(m_leftQueue.getSize(), 1u);
+    EXPECT_EQ(m_rightQueue.getSize(), 3u);
+}
+
+TEST_F(DispatcherTest, RemovedSubscriberKeepsTheOtherPorts) {
+    OutputPort left = m_dispatcher.Resolve("left");
+    OutputPort right = m_dispatcher.Resolve("right");
+    ASSERT_TRUE(m_dispatcher.RemoveSubscriber("left"));
+    EXPECT_FALSE(m_dispatcher.RemoveSubscriber("left"));
+
+    m_dispatcher.SendTo(left, MakeMessage(1)); // Ignored, the output is gone.
+    m_dispatcher.SendTo(right, MakeMessage(2));
+    m_dispatcher.Broadcast(MakeMessage(3));
+    EXPECT_EQ(m_leftQueue.getSize(), 0u);
+    EXPECT_EQ(m_rightQueue.getSize(), 2u);
+
+    EXPECT_FALSE(m_dispatcher.Resolve("left").IsValid());
+    EXPECT_EQ(m_dispatcher.GetSubscriberNames(), (std::vector<std::string>{"right"}));
+
+    // The name can be added again, it takes back its port instead of growing the routing.
+    m_dispatcher.AddSubscriber("left", ViewPtr<MessageQueue>(&m_leftQueue));
+    EXPECT_EQ(m_dispatcher.Resolve("left").GetIndex(), left.GetIndex());
+    EXPECT_EQ(m_dispatcher.GetSubscriberNames(), (std::vector<std::string>{"left", "right"}));
+    m_dispatcher.SendTo(left, MakeMessage(4));
+    EXPECT_EQ(m_leftQueue.getSize(), 1u);
+
+    for (int cycle = 0; cycle < 3; ++cycle) {
+        ASSERT_TRUE(m_dispatcher.RemoveSubscriber("right"));
+        m_dispatcher.AddSubscriber("right", ViewPtr<MessageQueue>(&m_rightQueue));
+    }
+    EXPECT_EQ(m_dispatcher.Resolve("right").GetIndex(), right.GetIndex());
+}
+
+TEST(DispatcherPartitionTest, SameKeyGoesToSameOutput) {
+    Config config;
+    config.Add("outputMode", std::string("partition"));
+    Dispatcher dispatcher{ViewPtr<Config>(&config)};
+    ASSERT_EQ(dispatcher.GetOutputMode(), nexusflow::dispatcher::OutputMode::PARTITION);
+
+    std::vector<std::unique_ptr<MessageQueue>> queues;
+    for (int idx = 0; idx < 3; ++idx) {
+        queues.push_back(std::make_unique<MessageQueue>());
+        dispatcher.AddSubscriber("Tracker" + std::to_string(idx), ViewPtr<MessageQueue>(queues.back().get()));
+    }
+
+    for (uint64_t streamId = 0; streamId < 30; ++streamId) {
+        for (int frame = 0; frame < 2; ++frame) {
+            auto msg = MakeMessage(frame);
+            msg.MetaData().streamId = streamId;
+            dispatcher.Dispatch(msg);
+        }
+    }
+
+    // Every message is delivered exactly once, and each stream stays on one output.
+    std::map<uint64_t, size_t> streamOwner;
+    size_t total = 0;
+    for (size_t idx = 0; idx < queues.size(); ++idx) {
+        Message msg;
+        while (queues[idx]->tryPop(msg)) {
+            auto inserted = streamOwner.emplace(msg.GetMetaData().streamId, idx);
+            EXPECT_EQ(inserted.first->second, idx);
+            ++total;
+        }
+    }
+    EXPECT_EQ(total, 60u);
+    EXPECT_EQ(streamOwner.size(), 30u);
+}
+
+TEST(DispatcherLoadBalanceTest, RoundRobinSkipsFullQueues) {
+    Config config;
+    config.Add("outputMode", std::string("round_robin"));
+    Dispatcher dispatcher{ViewPtr<Config>(&config)};
+
+    MessageQueue first{1};
+    MessageQueue second{4};
+    dispatcher.AddSubscriber("first", ViewPtr<MessageQueue>(&first));
+    dispatcher.AddSubscriber("second", ViewPtr<MessageQueue>(&second));
+
+    for (int idx = 0; idx < 4; ++idx) {
+        dispatcher.Dispatch(MakeMessage(idx));
+    }
+    // Alternates until `first` is full, then everything goes to `second`.
+    EXPECT_EQ(first.getSize(), 1u);
+    EXPECT_EQ(second.getSize(), 3u);
+}
+
+TEST(DispatcherLoadBalanceTest, LeastLoadedPicksShallowestOrFastest) {
+    Config config;
+    config.Add("outputMode", std::string("least_loaded"));
+    Dispatcher byDepth{ViewPtr<Config>(&config)};
+
+    MessageQueue busy;
+    MessageQueue idle;
+    busy.tryPush(MakeMessage(0));
+    busy.tryPush(MakeMessage(0));
+    byDepth.AddSubscriber("busy", ViewPtr<MessageQueue>(&busy));
+    byDepth.AddSubscriber("idle", ViewPtr<MessageQueue>(&idle));
+
+    byDepth.Dispatch(MakeMessage(1));
+    byDepth.Dispatch(MakeMessage(2));
+    EXPECT_EQ(busy.getSize(), 2u);
+    EXPECT_EQ(idle.getSize(), 2u);
+
+    // By latency, a fast consumer with a deeper queue still wins over a slow one.
+    config.Add("loadMetric", std::string("latency"));
+    Dispatcher byLatency{ViewPtr<Config>(&config)};
+    nexusflow::core::LoadStats slowStats;
+    nexusflow::core::LoadStats fastStats;
+    slowStats.RecordLatency(10000000);
+    fastStats.RecordLatency(1000);
+
+    MessageQueue slow;
+    MessageQueue fast;
+    fast.tryPush(MakeMessage(0));
+    fast.tryPush(MakeMessage(0));
+    byLatency.AddSubscriber("slow", ViewPtr<MessageQueue>(&slow), ViewPtr<const nexusflow::core::LoadStats>(&slowStats));
+    byLatency.AddSubscriber("fast", ViewPtr<MessageQueue>(&fast), ViewPtr<const nexusflow::core::LoadStats>(&fastStats));
+
+    byLatency.Dispatch(MakeMessage(3));
+    EXPECT_EQ(slow.getSize(), 0u);
+    EXPECT_EQ(fast.getSize(), 3u);
+}
+
+TEST(DispatcherMulticastTest, PublishesOnceToRing) {
+    Config config;
+    config.Add("outputMode", std::string("multicast"));
+    Dispatcher dispatcher{ViewPtr<Config>(&config)};
+
+    MessageQueue queue;
+    dispatcher.AddSubscriber("sink", ViewPtr<MessageQueue>(&queue));
+    MessageRing ring(4);
+    auto first = ring.addConsumer();
+    auto second = ring.addConsumer();
+    dispatcher.SetMulticastRing(ViewPtr<MessageRing>(&ring));
+
+    dispatcher.Dispatch(MakeMessage(5));
+    EXPECT_EQ(queue.getSize(), 0u);
+
+    Message fromFirst;
+    Message fromSecond;
+    ASSERT_TRUE(first.tryPop(fromFirst));
+    ASSERT_TRUE(second.tryPop(fromSecond));
+    EXPECT_EQ(fromFirst.Borrow<int>(), 5);
+    EXPECT_EQ(&fromFirst.Borrow<int>(), &fromSecond.Borrow<int>()); // Shared, not copied.
+}
+
+TEST(DispatcherWatermarkTest, ReachesEveryOutput) {
+    Config config;
+    config.Add("outputMode", std::string("partition"));
+    Dispatcher dispatcher{ViewPtr<Config>(&config)};
+    MessageQueue firstQueue;
+    MessageQueue secondQueue;
+    dispatcher.AddSubscriber("first", ViewPtr<MessageQueue>(&firstQueue));
+    dispatcher.AddSubscriber("second", ViewPtr<MessageQueue>(&secondQueue));
+
+    // A message goes to one partition, a watermark to all of them.
+    dispatcher.Dispatch(MakeMessage(1));
+    EXPECT_EQ(firstQueue.getSize() + secondQueue.getSize(), 1u);
+    dispatcher.DispatchWatermark(MakeMessage(Watermark{42}));
+    EXPECT_EQ(firstQueue.getSize() + secondQueue.getSize(), 3u);
+
+    Message msg;
+    while (secondQueue.tryPop(msg)) {
+    }
+    ASSERT_TRUE(msg.HasType<Watermark>());
+    EXPECT_EQ(msg.Borrow<Watermark>().eventTime, 42u);
+}
@@ -0,0 +1,141 @@
+#include "../Dispatcher.hpp"
+#include "../EdgeFilter.hpp"
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace nexusflow;
+using nexusflow::dispatcher::Dispatcher;
+using nexusflow::dispatcher::EdgeFilter;
+
+NEXUSFLOW_REGISTER_MESSAGE_PREDICATE(isEvenInt, [](const Message& msg) {
+    const int* value = msg.BorrowPtr<int>();
+    return value != nullptr && *value % 2 == 0;
+});
+
+TEST(EdgeFilterTest, NoFilterKeysMeansNoFilter) {
+    EXPECT_EQ(EdgeFilter::Create(Config()), nullptr);
+
+    Config config;
+    config.Add("sampleEveryN", 1);
+    EXPECT_EQ(EdgeFilter::Create(config), nullptr);
+
+    config.Add("predicate", std::string("noSuchPredicate"));
+    EXPECT_THROW(EdgeFilter::Create(config), std::invalid_argument);
+}
+
+TEST(EdgeFilterTest, PredicateThenSampling) {
+    Config config;
+    config.Add("predicate", std::string("isEvenInt"));
+    config.Add("sampleEveryN", 2);
+    auto filter = EdgeFilter::Create(config);
+    ASSERT_NE(filter, nullptr);
+
+    std::vector<int> accepted;
+    for (int value = 0; value < 12; ++value) {
+        if (filter->Accept(MakeMessage(value))) {
+            accepted.push_back(value);
+        }
+    }
+    // Every second even number: 0, 4, 8.
+    EXPECT_EQ(accepted, (std::vector<int>{0, 4, 8}));
+    EXPECT_FALSE(filter->Accept(MakeMessage(std::string("not an int"))));
+    EXPECT_EQ(filter->GetAcceptedCount(), 3u);
+    EXPECT_EQ(filter->GetRejectedCount(), 10u);
+}
+
+TEST(EdgeFilterTest, RateLimit) {
+    Config config;
+    config.Add("rateLimitHz", 20.0);
+    auto filter = EdgeFilter::Create(config);
+    ASSERT_NE(filter, nullptr);
+
+    EXPECT_TRUE(filter->Accept(MakeMessage(0)));
+    EXPECT_FALSE(filter->Accept(MakeMessage(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_TRUE(filter->Accept(MakeMessage(2)));
+}
+
+TEST(EdgeFilterTest, DispatcherSkipsRejectedMessages) {
+    Config moduleConfig;
+    Dispatcher dispatcher{ViewPtr<Config>(&moduleConfig)};
+
+    Config edgeConfig;
+    edgeConfig.Add("sampleEveryN", 5);
+    MessageQueue sampled;
+    MessageQueue full;
+    dispatcher.AddSubscriber("sampled", ViewPtr<MessageQueue>(&sampled), {}, EdgeFilter::Create(edgeConfig));
+    dispatcher.AddSubscriber("full", ViewPtr<MessageQueue>(&full));
+
+    for (int idx = 0; idx < 25; ++idx) {
+        dispatcher.Broadcast(MakeMessage(idx));
+    }
+    EXPECT_EQ(sampled.getSize(), 5u);
+    EXPECT_EQ(full.getSize(), 25u);
+
+    auto filter = dispatcher.GetFilter(dispatcher.Resolve("sampled"));
+    ASSERT_TRUE(filter);
+    EXPECT_EQ(filter->GetRejectedCount(), 20u);
+    EXPECT_FALSE(dispatcher.GetFilter(dispatcher.Resolve("full")));
+}
+
+TEST(EdgeFilterTest, LoadBalancingPassesRejectedMessagesOn) {
+    Config edgeConfig;
+    edgeConfig.Add("predicate", std::string("isEvenInt"));
+
+    Config roundRobinConfig;
+    roundRobinConfig.Add("outputMode", std::string("round_robin"));
+    Dispatcher roundRobin{ViewPtr<Config>(&roundRobinConfig)};
+    MessageQueue evenOnly;
+    MessageQueue any;
+    roundRobin.AddSubscriber("evenOnly", ViewPtr<MessageQueue>(&evenOnly), {}, EdgeFilter::Create(edgeConfig));
+    roundRobin.AddSubscriber("any", ViewPtr<MessageQueue>(&any));
+
+    // Odd messages whose turn is `evenOnly` go to `any` instead of being dropped.
+    for (int idx = 0; idx < 10; ++idx) {
+        roundRobin.Dispatch(MakeMessage(2 * idx + 1));
+    }
+    EXPECT_EQ(evenOnly.getSize(), 0u);
+    EXPECT_EQ(any.getSize(), 10u);
+    EXPECT_EQ(roundRobin.GetFilteredDropCount(), 0u);
+
+    Config leastLoadedConfig;
+    leastLoadedConfig.Add("outputMode", std::string("least_loaded"));
+    Dispatcher leastLoaded{ViewPtr<Config>(&leastLoadedConfig)};
+    MessageQueue idle;
+    MessageQueue busy;
+    busy.tryPush(MakeMessage(0));
+    leastLoaded.AddSubscriber("idle", ViewPtr<MessageQueue>(&idle), {}, EdgeFilter::Create(edgeConfig));
+    leastLoaded.AddSubscriber("busy", ViewPtr<MessageQueue>(&busy));
+
+    leastLoaded.Dispatch(MakeMessage(1));
+    EXPECT_EQ(idle.getSize(), 0u);
+    EXPECT_EQ(busy.getSize(), 2u);
+    EXPECT_EQ(leastLoaded.GetFilteredDropCount(), 0u);
+}
+
+TEST(EdgeFilterTest, PartitionDropsAndCountsRejectedMessages) {
+    Config moduleConfig;
+    moduleConfig.Add("outputMode", std::string("partition"));
+    Dispatcher dispatcher{ViewPtr<Config>(&moduleConfig)};
+
+    Config edgeConfig;
+    edgeConfig.Add("predicate", std::string("isEvenInt"));
+    MessageQueue first;
+    MessageQueue second;
+    dispatcher.AddSubscriber("first", ViewPtr<MessageQueue>(&first), {}, EdgeFilter::Create(edgeConfig));
+    dispatcher.AddSubscriber("second", ViewPtr<MessageQueue>(&second), {}, EdgeFilter::Create(edgeConfig));
+
+    for (int idx = 0; idx < 10; ++idx) {
+        auto msg = MakeMessage(idx);
+        msg.MetaData().streamId = static_cast<uint64_t>(idx + 1);
+        dispatcher.Dispatch(msg);
+    }
+    EXPECT_EQ(first.getSize() + second.getSize(), 5u);
+    EXPECT_EQ(dispatcher.GetFilteredDropCount(), 5u);
+
+    dispatcher.ResetFilters();
+    EXPECT_EQ(dispatcher.GetFilteredDropCount(), 0u);
+}
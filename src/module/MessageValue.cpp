@@ -0,0 +1,21 @@
+#include "nexusflow/MessageValue.hpp"
+
+namespace nexusflow {
+
+MessageValueRegistry& MessageValueRegistry::GetInstance() {
+    static MessageValueRegistry instance;
+    return instance;
+}
+
+void MessageValueRegistry::Register(const std::string& valueName, MessageValueExtractor extractor) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_extractors[valueName] = std::move(extractor);
+}
+
+MessageValueExtractor MessageValueRegistry::Find(const std::string& valueName) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_extractors.find(valueName);
+    return it != m_extractors.end() ? it->second : MessageValueExtractor();
+}
+
+} // namespace nexusflow
@@ -5,6 +5,8 @@
 #include "nexusflow/Message.hpp"
 #include "utils/logging.hpp"
 
+#include <algorithm>
+
 namespace nexusflow {
 
 Module::Module(std::string name) : m_moduleName(std::move(name)) {
@@ -23,6 +25,11 @@ ErrorCode Module::Configure(const Config& config) {
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode Module::OnReconfigure(const Config& config) {
+    LOG_WARN("Module '{}' does not support reconfiguration, ignoring {} keys.", m_moduleName, config.GetConfigMap().size());
+    return ErrorCode::FAILURE;
+}
+
 ErrorCode Module::Init() {
     // Initialize the module.
     LOG_TRACE("Module '{}' initializing...", m_moduleName);
@@ -43,10 +50,16 @@ void Module::ProcessBatch(std::vector<Message>& inputBatchMessages) {
     }
 }
 
+void Module::OnWatermark(uint64_t eventTime) { LOG_TRACE("Module '{}' reached watermark {}.", m_moduleName, eventTime); }
+
+void Module::OnDrain() { LOG_TRACE("Module '{}' drained.", m_moduleName); }
+
+void Module::WarmUp() {}
+
 void Module::Broadcast(const Message& message) {
     if (m_dispatcherPtr != nullptr) {
         LOG_DEBUG("Module '{}' broadcasting message.", m_moduleName);
-        m_dispatcherPtr->Broadcast(message);
+        m_dispatcherPtr->Dispatch(message);
     } else {
         LOG_WARN("Module '{}' has no handle, cannot broadcast message.", m_moduleName);
     }
@@ -61,6 +74,50 @@ void Module::SendTo(const std::string& outputName, const Message& msg) {
     }
 }
 
+void Module::SendTo(const OutputPort& port, const Message& msg) {
+    if (m_dispatcherPtr != nullptr) {
+        m_dispatcherPtr->SendTo(port, msg);
+    } else {
+        LOG_WARN("Module '{}' has no handle, cannot send message.", m_moduleName);
+    }
+}
+
+void Module::EmitWatermark(uint64_t eventTime) {
+    if (m_dispatcherPtr != nullptr) {
+        Message watermark = MakePooledMessage<Watermark>(m_moduleName);
+        watermark.Mut<Watermark>().eventTime = eventTime;
+        watermark.MetaData().eventTime = eventTime;
+        m_dispatcherPtr->DispatchWatermark(watermark);
+    } else {
+        LOG_WARN("Module '{}' has no handle, cannot emit watermark.", m_moduleName);
+    }
+}
+
+OutputPort Module::ResolveOutput(const std::string& outputName) const {
+    if (m_dispatcherPtr == nullptr) {
+        LOG_WARN("Module '{}' has no handle, cannot resolve output '{}'.", m_moduleName, outputName);
+        return {};
+    }
+    OutputPort port = m_dispatcherPtr->Resolve(outputName);
+    if (!port.IsValid()) {
+        LOG_WARN("Module '{}' has no output named '{}'.", m_moduleName, outputName);
+    }
+    return port;
+}
+
+std::vector<std::string> Module::GetOutputNames() const {
+    return m_dispatcherPtr != nullptr ? m_dispatcherPtr->GetSubscriberNames() : std::vector<std::string>{};
+}
+
+int Module::ResolveInput(const std::string& upstreamName) const {
+    auto it = std::lower_bound(m_inputNames.begin(), m_inputNames.end(), upstreamName);
+    if (it == m_inputNames.end() || *it != upstreamName) {
+        LOG_WARN("Module '{}' has no input '{}'.", m_moduleName, upstreamName);
+        return -1;
+    }
+    return static_cast<int>(it - m_inputNames.begin());
+}
+
 const std::string& Module::GetModuleName() const { return m_moduleName; }
 
 void Module::SetDispatcher(const std::shared_ptr<dispatcher::Dispatcher>& dispatcher) { m_dispatcherPtr = dispatcher; }
@@ -1,5 +1,6 @@
 #include "ModuleActor.hpp"
 #include "nexusflow/ErrorCode.hpp"
+#include <algorithm>
 #include <memory>
 
 namespace nexusflow {
@@ -16,22 +17,60 @@ ModuleActor::ModuleActor(const std::shared_ptr<Module>& module, const Config& co
     m_dispatcher = std::make_shared<dispatcher::Dispatcher>(configView);
 
     m_module->SetDispatcher(m_dispatcher);
+    m_worker->SetWatermarkSink([this](uint64_t eventTime) { m_module->EmitWatermark(eventTime); });
 }
 
 ModuleActor::~ModuleActor() = default;
 
+ViewPtr<MessageRing> ModuleActor::GetOutputRing(const std::string& outputName) {
+    if (m_dispatcher->GetOutputMode() != dispatcher::OutputMode::MULTICAST ||
+        m_dispatcher->IsQueueFed(m_dispatcher->Resolve(outputName))) {
+        return {};
+    }
+    if (!m_outputRing) {
+        constexpr int kDefaultRingCapacity = 16;
+        int capacity = m_config->GetValueOrDefault<int>("ringCapacity", kDefaultRingCapacity);
+        m_outputRing = std::make_unique<MessageRing>(static_cast<size_t>(std::max(capacity, 1)));
+        m_dispatcher->SetMulticastRing(makeViewPtr(m_outputRing.get()));
+    }
+    return makeViewPtr(m_outputRing.get());
+}
+
+bool ModuleActor::DetachOutputQueue(const std::string& name) {
+    if (auto filter = m_dispatcher->GetFilter(m_dispatcher->Resolve(name))) {
+        LOG_INFO("Connection '{} -> {}' filter accepted {} and rejected {} messages.", GetModuleName(), name,
+                 filter->GetAcceptedCount(), filter->GetRejectedCount());
+    }
+    return m_dispatcher->RemoveSubscriber(name);
+}
+
 ErrorCode ModuleActor::Init() { return m_module->Init(); }
 
-ErrorCode ModuleActor::DeInit() { return m_module->DeInit(); }
+ErrorCode ModuleActor::DeInit() {
+    for (const auto& outputName : m_dispatcher->GetSubscriberNames()) {
+        if (auto filter = m_dispatcher->GetFilter(m_dispatcher->Resolve(outputName))) {
+            LOG_INFO("Connection '{} -> {}' filter accepted {} and rejected {} messages.", GetModuleName(), outputName,
+                     filter->GetAcceptedCount(), filter->GetRejectedCount());
+        }
+    }
+    if (uint64_t filteredDropCount = m_dispatcher->GetFilteredDropCount()) {
+        LOG_INFO("'{}' dropped {} messages that the filters of their outputs rejected.", GetModuleName(), filteredDropCount);
+    }
+    return m_module->DeInit();
+}
 
 ErrorCode ModuleActor::Start() {
+    m_worker->BeginLoop();
     m_workThread = std::thread([this]() { m_worker->WorkLoop(); });
 
     return ErrorCode::SUCCESS;
 }
 
-ErrorCode ModuleActor::Stop() {
-    m_worker->Stop();
+ErrorCode ModuleActor::Stop(bool drain, core::TimerService::Clock::time_point drainDeadline) {
+    return m_worker->Stop(drain, drainDeadline);
+}
+
+ErrorCode ModuleActor::Join() {
     if (m_workThread.joinable()) {
         m_workThread.join();
     }
@@ -15,9 +15,55 @@ public:
 
     ~ModuleActor();
 
-    void AddInputQueue(const std::string& name, ViewPtr<MessageQueue> queue) { m_worker->AddQueue(name, queue); }
+    void AddInputQueue(const std::string& name, ViewPtr<MessageQueue> queue) {
+        m_worker->AddQueue(name, queue);
+        m_module->SetInputNames(m_worker->GetInputNames());
+    }
 
-    void AddOutputQueue(const std::string& name, ViewPtr<MessageQueue> queue) { m_dispatcher->AddSubscriber(name, queue); }
+    void AddOutputQueue(const std::string& name, ViewPtr<MessageQueue> queue, ViewPtr<const core::LoadStats> loadStats = {},
+                        const Config& edgeConfig = Config()) {
+        m_dispatcher->AddSubscriber(name, queue, loadStats, dispatcher::EdgeFilter::Create(edgeConfig));
+    }
+
+    // Adds an input queue, also while the module runs, see `core::Worker::AttachQueue()`.
+    ErrorCode AttachInputQueue(const std::string& name, ViewPtr<MessageQueue> queue) { return m_worker->AttachQueue(name, queue); }
+
+    // Removes an input queue, also while the module runs, see `core::Worker::DetachQueue()`.
+    ErrorCode DetachInputQueue(const std::string& name) { return m_worker->DetachQueue(name); }
+
+    // Adds an output, also while the module runs. It is fed through its queue even in multicast mode.
+    void AttachOutputQueue(const std::string& name, ViewPtr<MessageQueue> queue, ViewPtr<const core::LoadStats> loadStats,
+                           const Config& edgeConfig) {
+        m_dispatcher->AddSubscriber(name, queue, loadStats, dispatcher::EdgeFilter::Create(edgeConfig), true);
+    }
+
+    // Removes an output; returns once the module can no longer send to it. Returns false if there is no such output.
+    bool DetachOutputQueue(const std::string& name);
+
+    // Whether an output is read from the multicast ring. A ring keeps its readers, so such an output cannot be removed.
+    bool IsRingFed(const std::string& outputName) const {
+        return m_outputRing && !m_dispatcher->IsQueueFed(m_dispatcher->Resolve(outputName));
+    }
+
+    bool IsSyncInputs() const { return m_worker->IsSyncInputs(); }
+
+    bool HasInputs() const { return !m_worker->GetInputNames().empty(); }
+
+    // Whether the module runs as a source, see `core::Worker::IsRunningAsSource()`. It may lose all inputs and still read them.
+    bool IsRunningAsSource() const { return m_worker->IsRunningAsSource(); }
+
+    void AddInputRing(const std::string& name, ViewPtr<MessageRing> ring) {
+        m_worker->AddRing(name, ring);
+        m_module->SetInputNames(m_worker->GetInputNames());
+    }
+
+    ViewPtr<const core::LoadStats> GetLoadStats() const { return m_worker->GetLoadStats(); }
+
+    dispatcher::TapSet& GetTaps() { return m_dispatcher->GetTaps(); }
+
+    // Gets the ring feeding the given output, created on first use. Null unless `outputMode` is multicast
+    // and the output has no filter; filtered outputs are fed through their queue.
+    ViewPtr<MessageRing> GetOutputRing(const std::string& outputName);
 
     std::shared_ptr<Module>& GetModule() { return m_module; };
 
@@ -29,7 +75,31 @@ public:
 
     ErrorCode Start();
 
-    ErrorCode Stop();
+    // Signals the worker to stop, see `core::Worker::Stop()`. Call `Join()` to wait for it.
+    ErrorCode Stop(bool drain = false,
+                   core::TimerService::Clock::time_point drainDeadline = core::TimerService::Clock::time_point::min());
+
+    // Waits for the worker thread to exit.
+    ErrorCode Join();
+
+    // Hands a new config to the module, see `core::Worker::PostConfig()`.
+    void PostConfig(const Config& config) { m_worker->PostConfig(std::make_shared<const Config>(config)); }
+
+    size_t GetPendingInputCount() const { return m_worker->GetPendingInputCount(); }
+
+    size_t GetHeldDiscardedCount() const { return m_worker->GetHeldDiscardedCount(); }
+
+    // Makes the next run of the worker part of a warm-up, a module without outputs discards its input.
+    void BeginWarmUp() { m_worker->BeginWarmUp(m_dispatcher->GetSubscriberNames().empty()); }
+
+    // Sends one warm-up sample of a source module, whose worker does not run during the warm-up.
+    void WarmUpSource() { m_module->WarmUp(); }
+
+    // Ends the warm-up once the worker stopped and forgets its figures, see `core::Worker::EndWarmUp()`.
+    size_t EndWarmUp() {
+        m_dispatcher->ResetFilters();
+        return m_worker->EndWarmUp();
+    }
 
 private:
     std::shared_ptr<core::Worker>& GetWorker() { return m_worker; }
@@ -39,6 +109,7 @@ private:
     std::shared_ptr<core::Worker> m_worker;
     std::shared_ptr<dispatcher::Dispatcher> m_dispatcher;
     std::unique_ptr<Config> m_config;
+    MessageRingUPtr m_outputRing;
 
     std::thread m_workThread;
 };
@@ -1,3 +1,4 @@
+#include "module/WindowAggregateModule.hpp"
 #include "nexusflow/Config.hpp"
 #include "utils/logging.hpp" // Assuming you have a logger
 #include <nexusflow/ModuleFactory.hpp>
@@ -12,6 +13,10 @@ ModuleFactory& ModuleFactory::GetInstance() {
     return instance;
 }
 
+// The built-in modules are registered here rather than by a static registrar, which the linker
+// would drop from the static library.
+ModuleFactory::ModuleFactory() { Register<WindowAggregateModule>("WindowAggregateModule"); }
+
 // Implementation of the non-template member function.
 std::shared_ptr<Module> ModuleFactory::CreateModule(const std::string& className, const std::string& moduleName,
                                                     const Config& config) {
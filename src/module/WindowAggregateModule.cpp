@@ -0,0 +1,115 @@
+#include "WindowAggregateModule.hpp"
+#include "utils/logging.hpp"
+
+#include <cstdint>
+#include <utility>
+
+namespace nexusflow {
+
+namespace {
+constexpr uint64_t kNanosPerMs = 1000000;
+} // namespace
+
+WindowAggregateModule::WindowAggregateModule(std::string name) : Module(std::move(name)) {}
+
+ErrorCode WindowAggregateModule::Configure(const Config& config) {
+    core::WindowOptions options;
+
+    const auto windowType = config.GetValueOrDefault<std::string>("windowType", "tumbling");
+    if (windowType == "sliding") {
+        options.type = core::WindowType::SLIDING;
+    } else if (windowType == "session") {
+        options.type = core::WindowType::SESSION;
+    } else if (windowType != "tumbling") {
+        LOG_WARN("Unknown window type '{}', falling back to tumbling.", windowType);
+    }
+
+    const auto windowBy = config.GetValueOrDefault<std::string>("windowBy", "time");
+    if (windowBy == "count") {
+        options.measure = core::WindowMeasure::COUNT;
+    } else if (windowBy != "time") {
+        LOG_WARN("Unknown window measure '{}', falling back to time.", windowBy);
+    }
+
+    // Time windows are sized in ms, count windows in messages.
+    const bool isByCount = options.measure == core::WindowMeasure::COUNT && options.type != core::WindowType::SESSION;
+    const uint64_t unit = isByCount ? 1 : kNanosPerMs;
+    const int windowSize = config.GetValueOrDefault("windowSize", isByCount ? 100 : 10000);
+    const int windowSlide = config.GetValueOrDefault("windowSlide", windowSize);
+    const int sessionGapMs = config.GetValueOrDefault("sessionGapMs", 5000);
+    if (windowSize <= 0 || windowSlide <= 0 || sessionGapMs <= 0) {
+        LOG_ERROR("Module '{}' needs a positive windowSize, windowSlide and sessionGapMs.", GetModuleName());
+        return ErrorCode::FAILURE;
+    }
+    options.size = static_cast<uint64_t>(windowSize) * unit;
+    options.slide = static_cast<uint64_t>(windowSlide) * unit;
+    options.gap = static_cast<uint64_t>(sessionGapMs) * kNanosPerMs;
+
+    const auto keyBy = config.GetValueOrDefault<std::string>("keyBy", "");
+    if (!keyBy.empty()) {
+        m_keyExtractor = PartitionKeyRegistry::GetInstance().Find(keyBy);
+        if (!m_keyExtractor) {
+            LOG_WARN("Unknown window key '{}' for module '{}', aggregating all messages together.", keyBy, GetModuleName());
+        }
+    }
+    const auto valueName = config.GetValueOrDefault<std::string>("value", "");
+    if (!valueName.empty()) {
+        m_valueExtractor = MessageValueRegistry::GetInstance().Find(valueName);
+        if (!m_valueExtractor) {
+            LOG_WARN("Unknown message value '{}' for module '{}', only counting messages.", valueName, GetModuleName());
+        }
+    }
+
+    m_aggregator.reset(new core::WindowAggregator(options));
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode WindowAggregateModule::DeInit() {
+    if (m_aggregator) {
+        const auto& stats = m_aggregator->GetStats();
+        LOG_INFO("Windows of module '{}' finished: {} emitted, {} late, {} keys open.", GetModuleName(), stats.emittedCount,
+                 stats.lateCount, m_aggregator->GetKeyCount());
+    }
+    return ErrorCode::SUCCESS;
+}
+
+void WindowAggregateModule::Process(Message& inputMessage) {
+    if (!m_aggregator) {
+        return;
+    }
+    const uint64_t key = m_keyExtractor ? m_keyExtractor(inputMessage) : 0;
+    const double value = m_valueExtractor ? m_valueExtractor(inputMessage) : 0.0;
+    if (IsWarmingUp()) {
+        return; // Warm-up samples would stay in the open windows.
+    }
+    m_aggregator->Add(key, value, inputMessage.GetMetaData().eventTime, m_closed);
+    EmitClosed();
+}
+
+void WindowAggregateModule::OnWatermark(uint64_t eventTime) {
+    if (m_aggregator && !IsWarmingUp()) {
+        m_aggregator->Advance(eventTime, m_closed);
+        EmitClosed();
+    }
+}
+
+void WindowAggregateModule::OnDrain() {
+    if (m_aggregator && !IsWarmingUp()) {
+        m_aggregator->Flush(m_closed);
+        EmitClosed();
+    }
+}
+
+void WindowAggregateModule::EmitClosed() {
+    for (const auto& aggregate : m_closed) {
+        Message output = MakeMessage(aggregate, GetModuleName());
+        output.MetaData().eventTime = aggregate.windowEnd;
+        if (m_keyExtractor) {
+            output.MetaData().streamId = aggregate.key;
+        }
+        Broadcast(output);
+    }
+    m_closed.clear();
+}
+
+} // namespace nexusflow
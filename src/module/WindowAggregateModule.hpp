@@ -0,0 +1,51 @@
+#ifndef NEXUSFLOW_WINDOW_AGGREGATE_MODULE_HPP
+#define NEXUSFLOW_WINDOW_AGGREGATE_MODULE_HPP
+
+#include "core/WindowAggregator.hpp"
+#include "nexusflow/MessageValue.hpp"
+#include "nexusflow/Module.hpp"
+#include "nexusflow/PartitionKey.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nexusflow {
+
+/**
+ * @class WindowAggregateModule
+ * @brief A built-in module that emits a `WindowAggregate` for every window of its input that closes.
+ *
+ * Registered with the `ModuleFactory` as `WindowAggregateModule`. The windows are configured by
+ * `windowType`, `windowBy`, `windowSize`, `windowSlide` and `sessionGapMs`; `keyBy` names a
+ * partition key to aggregate each key on its own, and `value` a registered message value.
+ */
+class WindowAggregateModule : public Module {
+public:
+    explicit WindowAggregateModule(std::string name);
+
+    ErrorCode Configure(const Config& config) override;
+
+    ErrorCode DeInit() override;
+
+    void Process(Message& inputMessage) override;
+
+    // Closes the windows that end at or before the watermark, without waiting for a later message.
+    void OnWatermark(uint64_t eventTime) override;
+
+    // Closes the windows still open, a draining stop ends the input.
+    void OnDrain() override;
+
+private:
+    // Sends the windows in `m_closed` downstream.
+    void EmitClosed();
+
+    std::unique_ptr<core::WindowAggregator> m_aggregator;
+    PartitionKeyExtractor m_keyExtractor; // Empty if all messages share one window.
+    MessageValueExtractor m_valueExtractor; // Empty if only messages are counted.
+    std::vector<WindowAggregate> m_closed;
+};
+
+} // namespace nexusflow
+
+#endif // NEXUSFLOW_WINDOW_AGGREGATE_MODULE_HPP
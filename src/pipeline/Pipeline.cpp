@@ -9,12 +9,16 @@
 #include <nexusflow/ModuleFactory.hpp>
 
 #include "impl/PipelineImpl.hpp"
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <nexusflow/ErrorCode.hpp>
 #include <nexusflow/Module.hpp>
 #include <nexusflow/Pipeline.hpp>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace nexusflow {
 
@@ -24,6 +28,11 @@ Pipeline::~Pipeline() = default;
 
 void Pipeline::InitWithGraph(std::unique_ptr<Graph> graph) {
     LOG_DEBUG("Initializing pipeline with graph, graph={}", graph->toString());
+    const int initParallelism = graph->getConfig().GetValueOrDefault<int>("initParallelism", 0);
+    if (initParallelism < 0) {
+        LOG_WARN("Invalid initParallelism {}, falling back to 0 (a whole level at once).", initParallelism);
+    }
+    m_pImpl->initParallelism = static_cast<size_t>(std::max(initParallelism, 0));
     m_pImpl->graph = std::move(graph);
     m_pImpl->Init(); // Init the graph
 }
@@ -37,16 +46,18 @@ std::unique_ptr<Pipeline> Pipeline::CreateFromYaml(const std::string& configPath
 
 ErrorCode Pipeline::Init() {
     if (!m_pImpl) return ErrorCode::UNINITIALIZED_ERROR;
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
 
-    for (auto& actorNode : m_pImpl->actorOrderedNodes) {
-        ErrorCode errCode = actorNode->Init();
+    // The modules of a level are independent, they are initialized concurrently; levels run in order.
+    const auto startTime = core::TimerService::Now();
+    for (auto& level : m_pImpl->actorLevels) {
+        ErrorCode errCode = m_pImpl->RunOnLevel(level, "Init", &ActorNode::Init);
         if (errCode != ErrorCode::SUCCESS) {
-            LOG_ERROR("Init module failed, actorName={}", actorNode->GetModuleName());
             return errCode;
-        } else {
-            LOG_DEBUG("Init module success, actorName={}", actorNode->GetModuleName());
         }
     }
+    LOG_INFO("Pipeline initialized in {} ms.",
+             std::chrono::duration_cast<std::chrono::milliseconds>(core::TimerService::Now() - startTime).count());
     return ErrorCode::SUCCESS;
 }
 
@@ -55,16 +66,13 @@ ErrorCode Pipeline::DeInit() {
         return ErrorCode::SUCCESS; // Nothing to de-initialize
     }
     LOG_DEBUG("De-initializing pipeline...");
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
 
     // Reverse order
-    for (auto it = m_pImpl->actorOrderedNodes.rbegin(); it != m_pImpl->actorOrderedNodes.rend(); ++it) {
-        auto& actorNode = *it;
-        ErrorCode errCode = actorNode->DeInit();
+    for (auto levelIt = m_pImpl->actorLevels.rbegin(); levelIt != m_pImpl->actorLevels.rend(); ++levelIt) {
+        ErrorCode errCode = m_pImpl->RunOnLevel(*levelIt, "DeInit", &ActorNode::DeInit);
         if (errCode != ErrorCode::SUCCESS) {
-            LOG_ERROR("DeInit module failed, actorName={}", actorNode->GetModuleName());
             return errCode;
-        } else {
-            LOG_DEBUG("DeInit module success, actorName={}", actorNode->GetModuleName());
         }
     }
 
@@ -72,47 +80,209 @@ ErrorCode Pipeline::DeInit() {
     return ErrorCode::SUCCESS;
 }
 
+void Pipeline::SetInitParallelism(size_t maxParallelism) {
+    if (m_pImpl) {
+        std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+        m_pImpl->initParallelism = maxParallelism;
+    }
+}
+
+ErrorCode Pipeline::WarmUp(size_t sampleCount, std::chrono::milliseconds timeout) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    if (m_pImpl->isRunning) {
+        LOG_ERROR("Cannot warm up the pipeline while it runs.");
+        return ErrorCode::FAILED_ALREADY_START;
+    }
+    return m_pImpl->WarmUp(sampleCount, timeout);
+}
+
 ErrorCode Pipeline::Start() {
     if (!m_pImpl) {
         LOG_ERROR("Cannot start pipeline: not initialized.");
         return ErrorCode::UNINITIALIZED_ERROR;
     }
     LOG_DEBUG("Starting pipeline...");
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    m_pImpl->isRunning = true;
 
-    for (auto& actorNode : m_pImpl->actorOrderedNodes) {
-        ErrorCode errCode = actorNode->Start();
-        if (errCode != ErrorCode::SUCCESS) {
-            LOG_ERROR("Start worker failed, actorName={}", actorNode->GetModuleName());
-            return errCode;
-        } else {
-            LOG_DEBUG("Start module success, actorName={}", actorNode->GetModuleName());
-        }
+    ErrorCode errCode = m_pImpl->StartActors(true);
+    if (errCode == ErrorCode::SUCCESS) {
+        LOG_DEBUG("Pipeline started successfully.");
     }
-    LOG_DEBUG("Pipeline started successfully.");
-    return ErrorCode::SUCCESS;
+    return errCode;
 }
 
-ErrorCode Pipeline::Stop() {
+ErrorCode Pipeline::Stop(bool drain, std::chrono::milliseconds timeout, size_t* discardedCount) {
     if (!m_pImpl) {
         return ErrorCode::SUCCESS; // Nothing to stop.
     }
 
-    LOG_DEBUG("Stopping pipeline...");
-    // TODO: 优化一下.
+    LOG_DEBUG("Stopping pipeline, drain: {}...", drain);
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    m_pImpl->isRunning = false;
+    const auto startTime = core::TimerService::Now();
+
+    ErrorCode errCode = m_pImpl->StopActors(drain, startTime + timeout);
+
     for (auto& queue : m_pImpl->queues) {
-        queue->shutdown();
+        queue.second->shutdown();
     }
-    ErrorCode errCode = ErrorCode::SUCCESS;
-    for (auto& actorNode : m_pImpl->actorOrderedNodes) {
-        errCode = actorNode->Stop();
-        if (errCode != ErrorCode::SUCCESS) {
-            LOG_ERROR("Stop worker failed, actorName={}", actorNode->GetModuleName());
-            return errCode;
-        } else {
-            LOG_DEBUG("Stop module success, actorName={}", actorNode->GetModuleName());
+
+    const size_t pendingCount = m_pImpl->GetPendingInputCount();
+    const size_t heldCount = m_pImpl->GetHeldDiscardedCount();
+    if (discardedCount != nullptr) {
+        *discardedCount = pendingCount + heldCount;
+    }
+
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(core::TimerService::Now() - startTime).count();
+    if (pendingCount + heldCount > 0) {
+        LOG_WARN("Pipeline stopped in {} ms, {} messages in flight and {} held by joins were discarded.", elapsedMs,
+                 pendingCount, heldCount);
+    } else {
+        LOG_DEBUG("Pipeline stopped successfully in {} ms.", elapsedMs);
+    }
+    return errCode;
+}
+
+ErrorCode Pipeline::AddSubgraph(const std::vector<std::shared_ptr<Module>>& modules,
+                                const std::vector<std::pair<std::string, std::string>>& connections) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    return m_pImpl->AddSubgraph(modules, connections);
+}
+
+ErrorCode Pipeline::RemoveModule(const std::string& moduleName, std::chrono::milliseconds timeout, size_t* discardedCount) {
+    return RemoveSubgraph({moduleName}, timeout, discardedCount);
+}
+
+ErrorCode Pipeline::RemoveSubgraph(const std::vector<std::string>& moduleNames, std::chrono::milliseconds timeout,
+                                   size_t* discardedCount) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    return m_pImpl->RemoveSubgraph(moduleNames, timeout, discardedCount);
+}
+
+ErrorCode Pipeline::Connect(const std::string& srcModuleName, const std::string& dstModuleName, const Config& edgeConfig) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    return m_pImpl->Connect(srcModuleName, dstModuleName, edgeConfig);
+}
+
+ErrorCode Pipeline::Disconnect(const std::string& srcModuleName, const std::string& dstModuleName,
+                               std::chrono::milliseconds timeout) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    std::lock_guard<std::mutex> lock(m_pImpl->topologyMutex);
+    return m_pImpl->Disconnect(srcModuleName, dstModuleName, timeout);
+}
+
+ErrorCode Pipeline::Reconfigure(const std::string& moduleName, const Config& config) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    return m_pImpl->Reconfigure(moduleName, config);
+}
+
+ErrorCode Pipeline::WatchConfigFile(const std::string& configPath, std::chrono::milliseconds interval) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+    return m_pImpl->WatchConfigFile(configPath, interval);
+}
+
+void Pipeline::StopWatchingConfigFile() {
+    if (m_pImpl) {
+        m_pImpl->StopWatchingConfigFile();
+    }
+}
+
+TapId Pipeline::AttachTap(const std::string& moduleName, const std::shared_ptr<TapBuffer>& buffer, uint32_t sampleEveryN) {
+    if (!m_pImpl || !buffer) {
+        return kInvalidTapId;
+    }
+    auto actorNode = m_pImpl->FindActorNode(moduleName);
+    if (!actorNode) {
+        LOG_ERROR("Cannot attach tap: no module named '{}'.", moduleName);
+        return kInvalidTapId;
+    }
+
+    std::lock_guard<std::mutex> lock(m_pImpl->tapMutex);
+    TapId tapId = m_pImpl->nextTapId++;
+    m_pImpl->taps[tapId].moduleName = moduleName;
+    actorNode->GetTaps().Add(tapId, buffer, sampleEveryN);
+    LOG_INFO("Tap {} attached to module '{}', sampling every {} messages.", tapId, moduleName, sampleEveryN);
+    return tapId;
+}
+
+TapId Pipeline::AttachTap(const std::string& moduleName, TapCallback callback, uint32_t sampleEveryN, size_t capacity) {
+    if (!callback) {
+        return kInvalidTapId;
+    }
+    auto buffer = TapBuffer::Create(capacity);
+    TapId tapId = AttachTap(moduleName, buffer, sampleEveryN);
+    if (tapId == kInvalidTapId) {
+        return tapId;
+    }
+
+    auto stopFlag = std::make_shared<std::atomic<bool>>(false);
+    std::thread callbackThread([buffer, stopFlag, callback]() {
+        constexpr std::chrono::milliseconds kPollInterval{100};
+        Message msg;
+        while (!stopFlag->load()) {
+            if (buffer->WaitAndPopFor(msg, kPollInterval)) {
+                callback(msg);
+            }
         }
+    });
+
+    std::lock_guard<std::mutex> lock(m_pImpl->tapMutex);
+    auto it = m_pImpl->taps.find(tapId);
+    if (it == m_pImpl->taps.end()) {
+        // Detached concurrently, before the thread was registered.
+        stopFlag->store(true);
+        callbackThread.join();
+        return tapId;
+    }
+    it->second.stopFlag = std::move(stopFlag);
+    it->second.callbackThread = std::move(callbackThread);
+    return tapId;
+}
+
+ErrorCode Pipeline::DetachTap(TapId tapId) {
+    if (!m_pImpl) {
+        return ErrorCode::UNINITIALIZED_ERROR;
+    }
+
+    Impl::TapEntry entry;
+    {
+        std::lock_guard<std::mutex> lock(m_pImpl->tapMutex);
+        auto it = m_pImpl->taps.find(tapId);
+        if (it == m_pImpl->taps.end()) {
+            LOG_WARN("Cannot detach tap {}: not attached.", tapId);
+            return ErrorCode::FAILURE;
+        }
+        entry = std::move(it->second);
+        m_pImpl->taps.erase(it);
+    }
+
+    if (auto actorNode = m_pImpl->FindActorNode(entry.moduleName)) {
+        actorNode->GetTaps().Remove(tapId);
+    }
+    if (entry.callbackThread.joinable()) {
+        entry.stopFlag->store(true);
+        entry.callbackThread.join();
     }
-    LOG_DEBUG("Pipeline stopped successfully.");
+    LOG_INFO("Tap {} detached from module '{}'.", tapId, entry.moduleName);
     return ErrorCode::SUCCESS;
 }
 
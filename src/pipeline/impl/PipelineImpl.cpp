@@ -1,7 +1,11 @@
 #include "PipelineImpl.hpp"
 #include "base/Graph.hpp"
 #include <nexusflow/ModuleFactory.hpp>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace nexusflow {
 
@@ -10,9 +14,8 @@ std::shared_ptr<ActorNode> Pipeline::Impl::GetOrCreateActorNode(const std::share
     const auto& nodeName = node->name;
 
     // 检查 activeNodeMap 中是否已存在
-    auto it = actorModuleMap.find(nodeName);
-    if (it != actorModuleMap.end()) {
-        return it->second; // 已存在，直接返回
+    if (auto actorNode = FindActorNode(nodeName)) {
+        return actorNode; // 已存在，直接返回
     }
 
     // 不存在，则创建新的 ActiveNode
@@ -32,11 +35,286 @@ std::shared_ptr<ActorNode> Pipeline::Impl::GetOrCreateActorNode(const std::share
 
     // 2. 创建 ActiveNode 并存入 map
     auto actorNode = std::make_shared<ActorNode>(module, config);
+    std::lock_guard<std::mutex> lock(actorMutex);
     actorModuleMap.emplace(nodeName, actorNode);
 
     return actorNode;
 }
 
+Pipeline::Impl::~Impl() {
+    StopWatchingConfigFile();
+    std::lock_guard<std::mutex> lock(tapMutex);
+    for (auto& tap : taps) {
+        if (tap.second.callbackThread.joinable()) {
+            tap.second.stopFlag->store(true);
+            tap.second.callbackThread.join();
+        }
+    }
+}
+
+std::shared_ptr<ActorNode> Pipeline::Impl::FindActorNode(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(actorMutex);
+    auto it = actorModuleMap.find(name);
+    return it != actorModuleMap.end() ? it->second : nullptr;
+}
+
+ErrorCode Pipeline::Impl::RunOnLevel(const std::vector<std::shared_ptr<ActorNode>>& level, const char* stepName,
+                                     ErrorCode (ActorNode::*step)(), std::vector<ErrorCode>* results) const {
+    std::vector<ErrorCode> errCodes(level.size(), ErrorCode::SUCCESS);
+    std::atomic<size_t> nextIndex{0};
+    auto runNext = [&]() {
+        for (size_t idx = nextIndex++; idx < level.size(); idx = nextIndex++) {
+            auto& actorNode = *level[idx];
+            const auto startTime = core::TimerService::Now();
+            // The step runs on a thread of its own, an exception escaping it would terminate the process.
+            try {
+                errCodes[idx] = (actorNode.*step)();
+            } catch (const std::exception& e) {
+                LOG_ERROR("{} module '{}' threw: {}", stepName, actorNode.GetModuleName(), e.what());
+                errCodes[idx] = ErrorCode::FAILURE;
+            } catch (...) {
+                LOG_ERROR("{} module '{}' threw an unknown exception", stepName, actorNode.GetModuleName());
+                errCodes[idx] = ErrorCode::FAILURE;
+            }
+            const auto elapsedMs =
+                std::chrono::duration_cast<std::chrono::milliseconds>(core::TimerService::Now() - startTime).count();
+            if (errCodes[idx] != ErrorCode::SUCCESS) {
+                LOG_ERROR("{} module failed after {} ms, actorName={}", stepName, elapsedMs, actorNode.GetModuleName());
+            } else {
+                LOG_INFO("{} module '{}' took {} ms.", stepName, actorNode.GetModuleName(), elapsedMs);
+            }
+        }
+    };
+
+    // The calling thread takes part, a level of one module runs on it alone.
+    const size_t threadCount = std::min(initParallelism == 0 ? level.size() : initParallelism, level.size());
+    std::vector<std::thread> threads;
+    for (size_t idx = 1; idx < threadCount; ++idx) {
+        threads.emplace_back(runNext);
+    }
+    runNext();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (results != nullptr) {
+        *results = errCodes;
+    }
+    for (ErrorCode errCode : errCodes) {
+        if (errCode != ErrorCode::SUCCESS) {
+            return errCode;
+        }
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode Pipeline::Impl::StartActors(bool withSources) {
+    // Sinks first, sources last: nothing is sent before its consumer runs.
+    for (auto levelIt = actorLevels.rbegin(); levelIt != actorLevels.rend(); ++levelIt) {
+        for (auto& actorNode : *levelIt) {
+            if (!withSources && !actorNode->HasInputs()) {
+                continue;
+            }
+            ErrorCode errCode = actorNode->Start();
+            if (errCode != ErrorCode::SUCCESS) {
+                LOG_ERROR("Start worker failed, actorName={}", actorNode->GetModuleName());
+                return errCode;
+            } else {
+                LOG_DEBUG("Start module success, actorName={}", actorNode->GetModuleName());
+            }
+        }
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode Pipeline::Impl::StopActors(bool drain, core::TimerService::Clock::time_point deadline) {
+    // Without draining every worker is woken at once. With it, a level stops once the levels
+    // feeding it have, so its inputs cannot refill while it drains them; its workers drain in parallel.
+    ErrorCode errCode = ErrorCode::SUCCESS;
+    auto stopActors = [&errCode, drain, deadline](const std::vector<std::shared_ptr<ActorNode>>& actorNodes) {
+        for (auto& actorNode : actorNodes) {
+            if (actorNode->Stop(drain, deadline) != ErrorCode::SUCCESS) {
+                LOG_ERROR("Stop worker failed, actorName={}", actorNode->GetModuleName());
+                errCode = ErrorCode::FAILED_TO_STOP_WORKER;
+            }
+        }
+    };
+    auto joinActors = [](const std::vector<std::shared_ptr<ActorNode>>& actorNodes) {
+        for (auto& actorNode : actorNodes) {
+            actorNode->Join();
+            LOG_DEBUG("Stop module success, actorName={}", actorNode->GetModuleName());
+        }
+    };
+    if (drain) {
+        for (auto& level : actorLevels) {
+            stopActors(level);
+            joinActors(level);
+        }
+    } else {
+        for (auto& level : actorLevels) {
+            stopActors(level);
+        }
+        for (auto& level : actorLevels) {
+            joinActors(level);
+        }
+    }
+    return errCode;
+}
+
+size_t Pipeline::Impl::GetPendingInputCount() const {
+    size_t pendingCount = 0;
+    for (auto& level : actorLevels) {
+        for (auto& actorNode : level) {
+            pendingCount += actorNode->GetPendingInputCount();
+        }
+    }
+    return pendingCount;
+}
+
+size_t Pipeline::Impl::GetHeldDiscardedCount() const {
+    size_t discardedCount = 0;
+    for (auto& level : actorLevels) {
+        for (auto& actorNode : level) {
+            discardedCount += actorNode->GetHeldDiscardedCount();
+        }
+    }
+    return discardedCount;
+}
+
+ErrorCode Pipeline::Impl::WarmUp(size_t sampleCount, std::chrono::milliseconds timeout) {
+    const auto startTime = core::TimerService::Now();
+    const auto deadline = startTime + timeout;
+
+    std::vector<std::shared_ptr<ActorNode>> sourceNodes;
+    for (auto& level : actorLevels) {
+        for (auto& actorNode : level) {
+            actorNode->BeginWarmUp();
+            if (!actorNode->HasInputs()) {
+                sourceNodes.push_back(actorNode);
+            }
+        }
+    }
+
+    // The sources' workers stay stopped, their samples are sent from here. Every round holds one sample of
+    // every source, so joins find their groups, and starts once the previous one left the inputs, so no queue overflows.
+    ErrorCode errCode = StartActors(false);
+    size_t sentCount = 0;
+    for (; errCode == ErrorCode::SUCCESS && sentCount < sampleCount && core::TimerService::Now() < deadline; ++sentCount) {
+        while (GetPendingInputCount() > 0 && core::TimerService::Now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (auto& sourceNode : sourceNodes) {
+            sourceNode->WarmUpSource();
+        }
+    }
+    const ErrorCode stopErrCode = StopActors(true, deadline);
+    if (errCode == ErrorCode::SUCCESS) {
+        errCode = stopErrCode;
+    }
+
+    size_t discardedCount = 0;
+    for (auto& level : actorLevels) {
+        for (auto& actorNode : level) {
+            discardedCount += actorNode->EndWarmUp();
+        }
+    }
+
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(core::TimerService::Now() - startTime).count();
+    if (sentCount < sampleCount || discardedCount > 0) {
+        LOG_WARN("Pipeline warm-up timed out after {} ms: {} of {} samples sent, {} messages in flight discarded.", elapsedMs,
+                 sentCount, sampleCount, discardedCount);
+        return errCode == ErrorCode::SUCCESS ? ErrorCode::FAILURE : errCode;
+    }
+    LOG_INFO("Pipeline warmed up with {} samples in {} ms.", sampleCount, elapsedMs);
+    return errCode;
+}
+
+ErrorCode Pipeline::Impl::Reconfigure(const std::string& moduleName, const Config& config) {
+    auto actorNode = FindActorNode(moduleName);
+    if (!actorNode) {
+        LOG_ERROR("Cannot reconfigure: no module named '{}'.", moduleName);
+        return ErrorCode::FAILURE;
+    }
+    actorNode->PostConfig(config);
+    return ErrorCode::SUCCESS;
+}
+
+namespace {
+
+bool ReadFile(const std::string& path, std::string& text) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    text = oss.str();
+    return true;
+}
+
+} // namespace
+
+ErrorCode Pipeline::Impl::WatchConfigFile(const std::string& configPath, std::chrono::milliseconds interval) {
+    std::string yamlText;
+    std::unordered_map<std::string, graphutils::ModuleConfigEntry> moduleConfigs;
+    if (!ReadFile(configPath, yamlText) || !graphutils::ParseModuleConfigsFromYaml(yamlText, moduleConfigs)) {
+        LOG_ERROR("Cannot watch config file '{}': it cannot be read or parsed.", configPath);
+        return ErrorCode::FAILED_TO_OPEN_FILE;
+    }
+
+    StopWatchingConfigFile();
+    isWatchStopped = false;
+    watchThread = std::thread([this, configPath, interval, yamlText, moduleConfigs]() mutable {
+        std::unique_lock<std::mutex> lock(watchMutex);
+        while (!watchCondition.wait_for(lock, interval, [this]() { return isWatchStopped; })) {
+            std::string newText;
+            if (ReadFile(configPath, newText) && newText != yamlText) {
+                yamlText = std::move(newText);
+                ReloadConfigFile(configPath, yamlText, moduleConfigs);
+            }
+        }
+    });
+    LOG_INFO("Watching config file '{}' every {} ms.", configPath, interval.count());
+    return ErrorCode::SUCCESS;
+}
+
+void Pipeline::Impl::StopWatchingConfigFile() {
+    {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        isWatchStopped = true;
+    }
+    watchCondition.notify_all();
+    if (watchThread.joinable()) {
+        watchThread.join();
+    }
+}
+
+void Pipeline::Impl::ReloadConfigFile(const std::string& configPath, const std::string& yamlText,
+                                      std::unordered_map<std::string, graphutils::ModuleConfigEntry>& moduleConfigs) {
+    std::unordered_map<std::string, graphutils::ModuleConfigEntry> newConfigs;
+    if (!graphutils::ParseModuleConfigsFromYaml(yamlText, newConfigs)) {
+        LOG_ERROR("Config file '{}' changed but cannot be parsed, keeping the running config.", configPath);
+        return;
+    }
+    for (auto& entry : newConfigs) {
+        auto it = moduleConfigs.find(entry.first);
+        if (it == moduleConfigs.end()) {
+            LOG_WARN("Module '{}' was added to '{}', which takes a restart.", entry.first, configPath);
+            continue;
+        }
+        if (it->second.yamlText != entry.second.yamlText) {
+            LOG_INFO("Config of module '{}' changed in '{}', reconfiguring it.", entry.first, configPath);
+            Reconfigure(entry.first, entry.second.config);
+            it->second = std::move(entry.second);
+        }
+    }
+    for (const auto& entry : moduleConfigs) {
+        if (newConfigs.find(entry.first) == newConfigs.end()) {
+            LOG_WARN("Module '{}' was removed from '{}', which takes a restart.", entry.first, configPath);
+        }
+    }
+}
+
 ErrorCode Pipeline::Impl::Init() {
     LOG_TRACE("Try init pipeline with graph, [graphName={}]", graph->getName());
 
@@ -52,28 +330,409 @@ ErrorCode Pipeline::Impl::Init() {
             throw std::runtime_error("Expired node pointer in graph edge.");
         }
 
-        auto srcActorNode = GetOrCreateActorNode(srcNode);
-        auto dstActorNode = GetOrCreateActorNode(dstNode);
+        CreateEdgeQueue(GetOrCreateActorNode(srcNode), GetOrCreateActorNode(dstNode), edge.config, true);
+    }
 
-        constexpr int kQueueSize = 5;
-        auto queue = std::make_unique<MessageQueue>(kQueueSize);
-        auto queueView = makeViewPtr(queue.get());
+    UpdateActorLevels();
+    size_t actorCount = 0;
+    for (const auto& level : actorLevels) {
+        actorCount += level.size();
+    }
 
-        std::string queueName = srcNode->name + " -> " + dstNode->name;
+    CHECK(actorModuleMap.size() == actorCount, "actorModuleMap size != actors by level, [{} != {}]", actorModuleMap.size(),
+          actorCount);
 
-        srcActorNode->AddOutputQueue(queueName, queueView);
+    return ErrorCode::SUCCESS;
+}
+
+ViewPtr<MessageQueue> Pipeline::Impl::CreateEdgeQueue(const std::shared_ptr<ActorNode>& srcActorNode,
+                                                      const std::shared_ptr<ActorNode>& dstActorNode, const Config& edgeConfig,
+                                                      bool isInitial) {
+    constexpr int kQueueSize = 5;
+    auto queue = std::make_unique<MessageQueue>(kQueueSize);
+    auto queueView = makeViewPtr(queue.get());
+
+    const std::string dstName = dstActorNode->GetModuleName();
+    std::string queueName = srcActorNode->GetModuleName() + " -> " + dstName;
+
+    if (isInitial) {
+        // Outputs are named after the downstream module, which is what OutputPorts resolve.
+        srcActorNode->AddOutputQueue(dstName, queueView, dstActorNode->GetLoadStats(), edgeConfig);
         dstActorNode->AddInputQueue(queueName, queueView);
 
-        queues.push_back(std::move(queue));
+        // A multicast source additionally publishes to a single ring, each consumer reads it with its own cursor.
+        if (auto ring = srcActorNode->GetOutputRing(dstName)) {
+            dstActorNode->AddInputRing(queueName, ring);
+        }
+    } else {
+        dstActorNode->AttachInputQueue(queueName, queueView);
+    }
+
+    queues[queueName] = std::move(queue);
+    return queueView;
+}
+
+void Pipeline::Impl::AttachProducer(const std::shared_ptr<ActorNode>& srcActorNode, const std::shared_ptr<ActorNode>& dstActorNode,
+                                    const Config& edgeConfig) {
+    const std::string dstName = dstActorNode->GetModuleName();
+    auto queueView = makeViewPtr(queues.at(srcActorNode->GetModuleName() + " -> " + dstName).get());
+    srcActorNode->AttachOutputQueue(dstName, queueView, dstActorNode->GetLoadStats(), edgeConfig);
+}
+
+size_t Pipeline::Impl::DetachEdge(const std::string& srcName, const std::string& dstName,
+                                  core::TimerService::Clock::time_point deadline) {
+    const std::string queueName = srcName + " -> " + dstName;
+    auto queueIt = queues.find(queueName);
+    if (queueIt == queues.end()) {
+        return 0;
+    }
+    auto& queue = queueIt->second;
+
+    FindActorNode(srcName)->DetachOutputQueue(dstName);
+    // Only a running consumer empties the queue; it holds no more than its capacity.
+    auto dstActorNode = FindActorNode(dstName);
+    while (isRunning && queue->getSize() > 0 && core::TimerService::Now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    dstActorNode->DetachInputQueue(queueName);
+
+    const size_t leftCount = queue->getSize();
+    queues.erase(queueIt);
+    return leftCount;
+}
+
+void Pipeline::Impl::UpdateActorLevels() {
+    actorLevels.clear();
+    for (const auto& levelNames : graph->toTopologicalLevels()) {
+        std::vector<std::shared_ptr<ActorNode>> level;
+        for (const auto& name : levelNames) {
+            if (auto actorNode = FindActorNode(name)) {
+                level.push_back(std::move(actorNode));
+            }
+        }
+        actorLevels.push_back(std::move(level));
+    }
+}
+
+namespace {
+
+// The reason a running module cannot gain or lose an input, empty if it can.
+std::string GetInputChangeError(const ActorNode& actorNode, bool isRunning, bool isAdding) {
+    if (!isRunning) {
+        return {};
+    }
+    if (actorNode.IsSyncInputs()) {
+        return "it joins its inputs";
+    }
+    if (isAdding && actorNode.IsRunningAsSource()) {
+        return "it runs as a source";
+    }
+    return {};
+}
+
+} // namespace
+
+ErrorCode Pipeline::Impl::AddSubgraph(const std::vector<std::shared_ptr<Module>>& modules,
+                                      const std::vector<std::pair<std::string, std::string>>& connections) {
+    // Validate everything first, so a rejected subgraph leaves the pipeline untouched.
+    Graph newGraph = *graph;
+    std::unordered_map<std::string, std::shared_ptr<Node>> newNodes;
+    for (const auto& module : modules) {
+        if (!module) {
+            LOG_ERROR("Cannot add a null module.");
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+        const std::string& name = module->GetModuleName();
+        if (newGraph.findNode(name) || FindActorNode(name)) {
+            LOG_ERROR("Cannot add module '{}': the pipeline already has a module of that name.", name);
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+        auto node = std::make_shared<NodeWithModulePtr>(name, module);
+        newGraph.addNode(node);
+        newNodes.emplace(name, std::move(node));
+    }
+    for (const auto& connection : connections) {
+        auto srcNode = newGraph.findNode(connection.first);
+        auto dstNode = newGraph.findNode(connection.second);
+        if (!srcNode || !dstNode || newGraph.hasEdge(connection.first, connection.second)) {
+            LOG_ERROR("Cannot connect '{}' to '{}': a module is missing, or they are connected already.", connection.first,
+                      connection.second);
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+        if (newNodes.find(connection.second) == newNodes.end()) {
+            auto reason = GetInputChangeError(*FindActorNode(connection.second), isRunning, true);
+            if (!reason.empty()) {
+                LOG_ERROR("Cannot connect '{}' to running module '{}': {}.", connection.first, connection.second, reason);
+                return ErrorCode::FAILURE;
+            }
+        }
+        newGraph.addEdge(srcNode, dstNode);
+    }
+    if (newGraph.hasCycle()) {
+        LOG_ERROR("Cannot add the subgraph: it would close a cycle.");
+        return ErrorCode::INVALID_ARGUMENT;
+    }
+
+    *graph = std::move(newGraph);
+    for (const auto& entry : newNodes) {
+        GetOrCreateActorNode(entry.second);
+    }
+
+    // The new modules get all their inputs and outputs before Init, which resolves them. An upstream module
+    // already running only sends to a new module once it runs too.
+    std::vector<std::pair<std::string, std::string>> pendingProducers;
+    for (const auto& connection : connections) {
+        auto srcActorNode = FindActorNode(connection.first);
+        auto dstActorNode = FindActorNode(connection.second);
+        const bool isSrcNew = newNodes.find(connection.first) != newNodes.end();
+        const bool isDstNew = newNodes.find(connection.second) != newNodes.end();
+        CreateEdgeQueue(srcActorNode, dstActorNode, Config(), isSrcNew && isDstNew);
+        if (isSrcNew && !isDstNew) {
+            AttachProducer(srcActorNode, dstActorNode, Config());
+        } else if (!isSrcNew) {
+            pendingProducers.push_back(connection);
+        }
+    }
+    UpdateActorLevels();
+
+    std::vector<std::shared_ptr<ActorNode>> initializedActorNodes;
+    for (const auto& level : actorLevels) {
+        std::vector<std::shared_ptr<ActorNode>> newLevel;
+        for (const auto& actorNode : level) {
+            if (newNodes.find(actorNode->GetModuleName()) != newNodes.end()) {
+                newLevel.push_back(actorNode);
+            }
+        }
+        std::vector<ErrorCode> errCodes;
+        ErrorCode errCode = RunOnLevel(newLevel, "Init", &ActorNode::Init, &errCodes);
+        for (size_t idx = 0; idx < newLevel.size(); ++idx) {
+            if (errCodes[idx] == ErrorCode::SUCCESS) {
+                initializedActorNodes.push_back(newLevel[idx]);
+            }
+        }
+        if (errCode != ErrorCode::SUCCESS) {
+            LOG_ERROR("Init of the added modules failed, removing the subgraph again.");
+            std::vector<std::string> newNames;
+            for (const auto& entry : newNodes) {
+                newNames.push_back(entry.first);
+            }
+            RollBackSubgraph(newNames, connections, initializedActorNodes);
+            return errCode;
+        }
+    }
 
-        // store ordered actor nodes
-        actorOrderedNodes.insert(srcActorNode);
-        actorOrderedNodes.insert(dstActorNode);
+    if (isRunning) {
+        // Sinks first, as on Start.
+        for (auto levelIt = actorLevels.rbegin(); levelIt != actorLevels.rend(); ++levelIt) {
+            for (auto& actorNode : *levelIt) {
+                if (newNodes.find(actorNode->GetModuleName()) != newNodes.end()) {
+                    actorNode->Start();
+                }
+            }
+        }
     }
+    for (const auto& connection : pendingProducers) {
+        AttachProducer(FindActorNode(connection.first), FindActorNode(connection.second), Config());
+    }
+
+    LOG_INFO("Added {} modules and {} connections to the pipeline.", modules.size(), connections.size());
+    return ErrorCode::SUCCESS;
+}
+
+void Pipeline::Impl::RollBackSubgraph(const std::vector<std::string>& moduleNames,
+                                     const std::vector<std::pair<std::string, std::string>>& connections,
+                                     const std::vector<std::shared_ptr<ActorNode>>& initializedActorNodes) {
+    auto isRemoved = [&moduleNames](const std::string& name) {
+        return std::find(moduleNames.begin(), moduleNames.end(), name) != moduleNames.end();
+    };
 
-    CHECK(actorModuleMap.size() == actorOrderedNodes.size(), "actorModuleMap size != actorOrderedNodes size, [{} != {}]",
-          actorModuleMap.size(), actorOrderedNodes.size());
+    // Nothing was sent through the connections yet; a module kept only has to stop reading its new input.
+    for (const auto& connection : connections) {
+        const std::string queueName = connection.first + " -> " + connection.second;
+        if (!isRemoved(connection.second)) {
+            FindActorNode(connection.second)->DetachInputQueue(queueName);
+        }
+        queues.erase(queueName);
+    }
 
+    for (auto it = initializedActorNodes.rbegin(); it != initializedActorNodes.rend(); ++it) {
+        (*it)->DeInit();
+    }
+    {
+        std::lock_guard<std::mutex> lock(actorMutex);
+        for (const auto& name : moduleNames) {
+            actorModuleMap.erase(name);
+        }
+    }
+    for (const auto& name : moduleNames) {
+        graph->removeNode(name);
+    }
+    UpdateActorLevels();
+}
+
+ErrorCode Pipeline::Impl::RemoveSubgraph(const std::vector<std::string>& moduleNames, std::chrono::milliseconds timeout,
+                                         size_t* discardedCount) {
+    const auto deadline = core::TimerService::Now() + timeout;
+    std::unordered_map<std::string, std::shared_ptr<ActorNode>> removedActorNodes;
+    for (const auto& name : moduleNames) {
+        auto actorNode = FindActorNode(name);
+        if (!actorNode) {
+            LOG_ERROR("Cannot remove module '{}': there is no such module.", name);
+            return ErrorCode::INVALID_ARGUMENT;
+        }
+        removedActorNodes.emplace(name, std::move(actorNode));
+    }
+    auto isRemoved = [&removedActorNodes](const std::string& name) {
+        return removedActorNodes.find(name) != removedActorNodes.end();
+    };
+
+    // The edges crossing the boundary of the removed modules, validated before anything changes.
+    std::vector<std::pair<std::string, std::string>> incomingEdges, outgoingEdges, innerEdges;
+    for (const auto& edge : graph->toEdgeListBFS()) {
+        const std::string srcName = edge.srcNodePtr.lock()->name;
+        const std::string dstName = edge.dstNodePtr.lock()->name;
+        if (!isRemoved(srcName) && !isRemoved(dstName)) {
+            continue;
+        }
+        if (isRemoved(srcName) && isRemoved(dstName)) {
+            innerEdges.emplace_back(srcName, dstName);
+            continue;
+        }
+        if (FindActorNode(srcName)->IsRingFed(dstName)) {
+            LOG_ERROR("Cannot remove the connection '{} -> {}': it is read from a multicast ring.", srcName, dstName);
+            return ErrorCode::FAILURE;
+        }
+        if (isRemoved(srcName)) {
+            auto reason = GetInputChangeError(*FindActorNode(dstName), isRunning, false);
+            if (!reason.empty()) {
+                LOG_ERROR("Cannot remove the input '{}' of running module '{}': {}.", srcName, dstName, reason);
+                return ErrorCode::FAILURE;
+            }
+            outgoingEdges.emplace_back(srcName, dstName);
+        } else {
+            incomingEdges.emplace_back(srcName, dstName);
+        }
+    }
+
+    // No message enters the removed modules anymore; those in flight are drained level by level, as on Stop.
+    size_t leftCount = 0;
+    for (const auto& edge : incomingEdges) {
+        FindActorNode(edge.first)->DetachOutputQueue(edge.second);
+    }
+    std::vector<std::vector<std::shared_ptr<ActorNode>>> removedLevels;
+    for (const auto& level : actorLevels) {
+        std::vector<std::shared_ptr<ActorNode>> removedLevel;
+        for (const auto& actorNode : level) {
+            if (isRemoved(actorNode->GetModuleName())) {
+                removedLevel.push_back(actorNode);
+            }
+        }
+        if (!removedLevel.empty()) {
+            removedLevels.push_back(std::move(removedLevel));
+        }
+    }
+    if (isRunning) {
+        for (const auto& level : removedLevels) {
+            for (const auto& actorNode : level) {
+                actorNode->Stop(true, deadline);
+            }
+            for (const auto& actorNode : level) {
+                actorNode->Join();
+            }
+        }
+    }
+    for (const auto& edge : outgoingEdges) {
+        leftCount += DetachEdge(edge.first, edge.second, deadline);
+    }
+    for (const auto& level : removedLevels) {
+        for (const auto& actorNode : level) {
+            leftCount += actorNode->GetPendingInputCount() + actorNode->GetHeldDiscardedCount();
+        }
+    }
+
+    for (auto levelIt = removedLevels.rbegin(); levelIt != removedLevels.rend(); ++levelIt) {
+        for (const auto& actorNode : *levelIt) {
+            actorNode->DeInit();
+        }
+    }
+    for (const auto& edges : {incomingEdges, innerEdges}) {
+        for (const auto& edge : edges) {
+            queues.erase(edge.first + " -> " + edge.second);
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(actorMutex);
+        for (const auto& entry : removedActorNodes) {
+            actorModuleMap.erase(entry.first);
+        }
+    }
+    for (const auto& entry : removedActorNodes) {
+        graph->removeNode(entry.first);
+    }
+    UpdateActorLevels();
+
+    if (discardedCount != nullptr) {
+        *discardedCount = leftCount;
+    }
+    if (leftCount > 0) {
+        LOG_WARN("Removed {} modules from the pipeline, {} messages in flight were discarded.", removedActorNodes.size(),
+                 leftCount);
+    } else {
+        LOG_INFO("Removed {} modules from the pipeline.", removedActorNodes.size());
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode Pipeline::Impl::Connect(const std::string& srcName, const std::string& dstName, const Config& edgeConfig) {
+    auto srcActorNode = FindActorNode(srcName);
+    auto dstActorNode = FindActorNode(dstName);
+    if (!srcActorNode || !dstActorNode || graph->hasEdge(srcName, dstName)) {
+        LOG_ERROR("Cannot connect '{}' to '{}': a module is missing, or they are connected already.", srcName, dstName);
+        return ErrorCode::INVALID_ARGUMENT;
+    }
+    auto reason = GetInputChangeError(*dstActorNode, isRunning, true);
+    if (!reason.empty()) {
+        LOG_ERROR("Cannot connect '{}' to running module '{}': {}.", srcName, dstName, reason);
+        return ErrorCode::FAILURE;
+    }
+    Graph newGraph = *graph;
+    newGraph.addEdge(newGraph.findNode(srcName), newGraph.findNode(dstName), edgeConfig);
+    if (newGraph.hasCycle()) {
+        LOG_ERROR("Cannot connect '{}' to '{}': it would close a cycle.", srcName, dstName);
+        return ErrorCode::INVALID_ARGUMENT;
+    }
+
+    *graph = std::move(newGraph);
+    CreateEdgeQueue(srcActorNode, dstActorNode, edgeConfig, false);
+    AttachProducer(srcActorNode, dstActorNode, edgeConfig);
+    UpdateActorLevels();
+    LOG_INFO("Connected '{}' to '{}'.", srcName, dstName);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode Pipeline::Impl::Disconnect(const std::string& srcName, const std::string& dstName, std::chrono::milliseconds timeout) {
+    if (!graph->hasEdge(srcName, dstName)) {
+        LOG_ERROR("Cannot disconnect '{}' from '{}': they are not connected.", srcName, dstName);
+        return ErrorCode::INVALID_ARGUMENT;
+    }
+    if (FindActorNode(srcName)->IsRingFed(dstName)) {
+        LOG_ERROR("Cannot remove the connection '{} -> {}': it is read from a multicast ring.", srcName, dstName);
+        return ErrorCode::FAILURE;
+    }
+    auto reason = GetInputChangeError(*FindActorNode(dstName), isRunning, false);
+    if (!reason.empty()) {
+        LOG_ERROR("Cannot remove the input '{}' of running module '{}': {}.", srcName, dstName, reason);
+        return ErrorCode::FAILURE;
+    }
+
+    const size_t leftCount = DetachEdge(srcName, dstName, core::TimerService::Now() + timeout);
+    graph->removeEdge(srcName, dstName);
+    UpdateActorLevels();
+    if (leftCount > 0) {
+        LOG_WARN("Disconnected '{}' from '{}', {} messages in flight were discarded.", srcName, dstName, leftCount);
+    } else {
+        LOG_INFO("Disconnected '{}' from '{}'.", srcName, dstName);
+    }
     return ErrorCode::SUCCESS;
 }
 
@@ -3,12 +3,20 @@
 
 #include "base/Define.hpp"
 #include "base/Graph.hpp"
+#include "base/GraphUtils.hpp"
 #include "core/Worker.hpp"
 #include "dispatcher/Dispatcher.hpp"
 #include "module/ModuleActor.hpp"
 #include <nexusflow/Pipeline.hpp>
-#include <set>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace nexusflow {
 
@@ -23,15 +31,120 @@ using ActorNode = ModuleActor;
 class Pipeline::Impl {
 public:
     std::unique_ptr<Graph> graph;
-    std::vector<MessageQueueUPtr> queues;
+    std::unordered_map<std::string, MessageQueueUPtr> queues; // By queue name, "src -> dst".
 
-    std::set<std::shared_ptr<ActorNode>> actorOrderedNodes;
+    // The actors by topological level of their module, sources first; no actor feeds another of its level.
+    std::vector<std::vector<std::shared_ptr<ActorNode>>> actorLevels;
+
+    // Serializes Init, Start, Stop, DeInit and the topology changes, which all walk `actorLevels` and `graph`.
+    std::mutex topologyMutex;
+    bool isRunning = false; // Between Start and Stop.
+
+    size_t initParallelism = 0; // How many modules of a level Init and DeInit run at once, 0 means all.
+
+    ~Impl();
 
     ErrorCode Init();
 
+    // Thread-safe.
+    std::shared_ptr<ActorNode> FindActorNode(const std::string& name) const;
+
+    /**
+     * @brief Runs a lifecycle step, such as `ActorNode::Init`, on the actors of one level, up to `initParallelism`
+     * at once, and logs how long each took. The actors of a level never feed each other.
+     * @param errCodes Receives the result of every actor, by index in the level, if not null.
+     * @return The first error of the level, after every actor ran.
+     */
+    ErrorCode RunOnLevel(const std::vector<std::shared_ptr<ActorNode>>& level, const char* stepName,
+                         ErrorCode (ActorNode::*step)(), std::vector<ErrorCode>* errCodes = nullptr) const;
+
+    // --- Lifecycle, call with `topologyMutex` held ---
+
+    // Starts the workers, consumers before producers; without `withSources` the sources stay stopped.
+    ErrorCode StartActors(bool withSources);
+
+    // Stops the workers level by level and waits for them, see `Pipeline::Stop()`.
+    ErrorCode StopActors(bool drain, core::TimerService::Clock::time_point deadline);
+
+    // The number of messages waiting in the inputs of all actors.
+    size_t GetPendingInputCount() const;
+
+    // The number of messages the joins of all actors held and dropped when their workers last stopped.
+    size_t GetHeldDiscardedCount() const;
+
+    // Runs a warm-up on the stopped pipeline, see `Pipeline::WarmUp()`.
+    ErrorCode WarmUp(size_t sampleCount, std::chrono::milliseconds timeout);
+
+    // --- Topology changes, call with `topologyMutex` held ---
+    ErrorCode AddSubgraph(const std::vector<std::shared_ptr<Module>>& modules,
+                          const std::vector<std::pair<std::string, std::string>>& connections);
+
+    ErrorCode RemoveSubgraph(const std::vector<std::string>& moduleNames, std::chrono::milliseconds timeout,
+                             size_t* discardedCount);
+
+    ErrorCode Connect(const std::string& srcName, const std::string& dstName, const Config& edgeConfig);
+
+    ErrorCode Disconnect(const std::string& srcName, const std::string& dstName, std::chrono::milliseconds timeout);
+
+    ErrorCode Reconfigure(const std::string& moduleName, const Config& config);
+
+    // --- Config file watching ---
+    ErrorCode WatchConfigFile(const std::string& configPath, std::chrono::milliseconds interval);
+
+    void StopWatchingConfigFile();
+
+    // --- Taps ---
+    struct TapEntry {
+        std::string moduleName;
+        std::shared_ptr<std::atomic<bool>> stopFlag; // Callback taps only.
+        std::thread callbackThread; // Callback taps only, drains the tap's buffer.
+    };
+
+    std::mutex tapMutex;
+    std::unordered_map<TapId, TapEntry> taps;
+    TapId nextTapId = kInvalidTapId + 1;
+
 private:
+    // Reconfigures the modules whose config differs in the file's current text from `moduleConfigs`, which it updates.
+    void ReloadConfigFile(const std::string& configPath, const std::string& yamlText,
+                          std::unordered_map<std::string, graphutils::ModuleConfigEntry>& moduleConfigs);
+
+    std::mutex watchMutex;
+    std::condition_variable watchCondition;
+    bool isWatchStopped = false;
+    std::thread watchThread;
+
     std::shared_ptr<ActorNode> GetOrCreateActorNode(const std::shared_ptr</*Graph::*/ Node>& node);
 
+    // Creates the queue of an edge and wires its consumer side, see `AttachProducer()`. With `isInitial`
+    // the edge is wired as on Init, the producer side included, which may feed it through a multicast ring.
+    ViewPtr<MessageQueue> CreateEdgeQueue(const std::shared_ptr<ActorNode>& srcActorNode,
+                                          const std::shared_ptr<ActorNode>& dstActorNode, const Config& edgeConfig,
+                                          bool isInitial);
+
+    // Wires the producer side of an edge created by `CreateEdgeQueue()`, after its consumer is ready.
+    void AttachProducer(const std::shared_ptr<ActorNode>& srcActorNode, const std::shared_ptr<ActorNode>& dstActorNode,
+                        const Config& edgeConfig);
+
+    /**
+     * @brief Takes the queue of an edge out of a possibly running pipeline: the producer stops sending to it,
+     * the consumer drains it until `deadline` and stops reading it. The queue is destroyed.
+     * @return The number of messages left in the queue.
+     */
+    size_t DetachEdge(const std::string& srcName, const std::string& dstName, core::TimerService::Clock::time_point deadline);
+
+    /**
+     * @brief Takes a subgraph whose modules failed to initialize out again. None of them was started, nor
+     * fed by a module already running. Only the modules in `initializedActorNodes` are de-initialized.
+     */
+    void RollBackSubgraph(const std::vector<std::string>& moduleNames,
+                          const std::vector<std::pair<std::string, std::string>>& connections,
+                          const std::vector<std::shared_ptr<ActorNode>>& initializedActorNodes);
+
+    // Regroups the actors by topological level after the graph changed.
+    void UpdateActorLevels();
+
+    mutable std::mutex actorMutex; // Guards `actorModuleMap`.
     std::unordered_map<ActorName, std::shared_ptr<ActorNode>> actorModuleMap;
 };
 
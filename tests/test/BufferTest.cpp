@@ -0,0 +1,141 @@
+#include "nexusflow/Buffer.hpp"
+#include "nexusflow/BufferPool.hpp"
+#include "nexusflow/Message.hpp"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace nexusflow;
+
+namespace {
+struct Frame {
+    uint32_t frameId = 0;
+    Buffer data;
+};
+} // namespace
+
+TEST(BufferTest, AllocateAndSlice) {
+    const std::string text = "hello buffer";
+    Buffer buffer = Buffer::CopyFrom(text.data(), text.size());
+
+    ASSERT_EQ(buffer.Size(), text.size());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.Data()) % Buffer::kDefaultAlignment, 0u);
+    EXPECT_EQ(buffer.ToString(), text);
+
+    // A slice shares the slab, it does not copy.
+    Buffer slice = buffer.Slice(6, 6);
+    EXPECT_EQ(slice.ToString(), "buffer");
+    EXPECT_EQ(slice.Data(), buffer.Data() + 6);
+    EXPECT_EQ(buffer.UseCount(), 2);
+
+    EXPECT_THROW(buffer.Slice(6, 7), std::out_of_range);
+    EXPECT_TRUE(Buffer().Empty());
+}
+
+TEST(BufferTest, MutableOnlyWhenUnique) {
+    Buffer buffer = Buffer::Allocate(16);
+    ASSERT_NE(buffer.MutableData(), nullptr);
+
+    Buffer shared = buffer;
+    EXPECT_EQ(buffer.MutableData(), nullptr);
+    EXPECT_EQ(shared.MutableData(), nullptr);
+}
+
+TEST(BufferTest, MessageCowDoesNotCopyBytes) {
+    Frame frame;
+    frame.data = Buffer::Allocate(1024);
+    const uint8_t* pixels = frame.data.Data();
+
+    auto original = MakeMessage(std::move(frame));
+    auto branch = original;
+
+    // The COW detach copies the Frame, the frame bytes stay shared.
+    branch.Mut<Frame>().frameId = 7;
+    EXPECT_EQ(original.Borrow<Frame>().frameId, 0u);
+    EXPECT_EQ(branch.Borrow<Frame>().data.Data(), pixels);
+    EXPECT_EQ(original.Borrow<Frame>().data.Data(), pixels);
+}
+
+TEST(BufferPoolTest, RecycleOnLastRelease) {
+    BufferPoolOptions options;
+    options.bufferSize = 100;
+    options.initialCount = 2;
+    auto pool = BufferPool::Create(options);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_EQ(pool->GetTotalCount(), 2u);
+    EXPECT_EQ(pool->GetIdleCount(), 2u);
+
+    const uint8_t* slabAddr = nullptr;
+    {
+        Buffer buffer = pool->Acquire();
+        ASSERT_EQ(buffer.Size(), 100u);
+        slabAddr = buffer.Data();
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(slabAddr) % options.alignment, 0u);
+        EXPECT_EQ(pool->GetIdleCount(), 1u);
+
+        Buffer slice = buffer.Slice(10, 10);
+        buffer = Buffer();
+        EXPECT_EQ(pool->GetIdleCount(), 1u); // The slice still holds the slab.
+    }
+    EXPECT_EQ(pool->GetIdleCount(), 2u);
+
+    // The recycled slab is handed out again, no new allocation happens.
+    Buffer again = pool->Acquire();
+    EXPECT_EQ(again.Data(), slabAddr);
+    EXPECT_EQ(pool->GetTotalCount(), 2u);
+}
+
+TEST(BufferPoolTest, MaxCountAndPoolLifetime) {
+    BufferPoolOptions options;
+    options.bufferSize = 64;
+    options.maxCount = 1;
+    auto pool = BufferPool::Create(options);
+    ASSERT_NE(pool, nullptr);
+
+    Buffer buffer = pool->Acquire();
+    ASSERT_FALSE(buffer.Empty());
+    EXPECT_TRUE(pool->Acquire().Empty());
+
+    // The memory outlives the pool object until the last buffer is released.
+    pool.reset();
+    std::memset(buffer.MutableData(), 0xAB, buffer.Size());
+    EXPECT_EQ(buffer.Data()[63], 0xAB);
+}
+
+TEST(BufferPoolTest, HugePagesFallBackGracefully) {
+    BufferPoolOptions options;
+    options.bufferSize = 4096;
+    options.initialCount = 4;
+    options.useHugePages = true;
+    auto pool = BufferPool::Create(options);
+    ASSERT_NE(pool, nullptr);
+    EXPECT_GE(pool->GetTotalCount(), 4u);
+
+    std::vector<std::thread> threads;
+    for (int idx = 0; idx < 4; ++idx) {
+        threads.emplace_back([&pool]() {
+            for (int round = 0; round < 1000; ++round) {
+                Buffer buffer = pool->Acquire();
+                ASSERT_NE(buffer.MutableData(), nullptr);
+                buffer.MutableData()[0] = static_cast<uint8_t>(round);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(pool->GetIdleCount(), pool->GetTotalCount());
+}
+
+TEST(BufferPoolTest, InvalidOptions) {
+    BufferPoolOptions options;
+    EXPECT_EQ(BufferPool::Create(options), nullptr);
+
+    options.bufferSize = 64;
+    options.alignment = 48;
+    EXPECT_EQ(BufferPool::Create(options), nullptr);
+}
@@ -0,0 +1,40 @@
+#include "nexusflow/JoinedMessage.hpp"
+#include "nexusflow/Message.hpp"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+using namespace nexusflow;
+
+TEST(JoinedMessageTest, PartsByIndex) {
+    JoinedMessage joined(3);
+    ASSERT_EQ(joined.Size(), 3u);
+    joined.Set(0, MakeMessage(10));
+    joined.Set(2, MakeMessage(12));
+
+    EXPECT_TRUE(joined.Has(0));
+    EXPECT_FALSE(joined.Has(1)); // Did not deliver.
+    EXPECT_FALSE(joined.Has(-1)); // An unresolved input.
+    EXPECT_FALSE(joined.Has(3));
+    EXPECT_EQ(joined.Get(2).Borrow<int>(), 12);
+    EXPECT_FALSE(joined.Get(1).HasData());
+
+    EXPECT_THROW(joined.Get(3), std::out_of_range);
+    EXPECT_THROW(joined.Set(-1, MakeMessage(0)), std::out_of_range);
+    EXPECT_THROW(JoinedMessage(JoinedMessage::kMaxInputs + 1), std::length_error);
+}
+
+TEST(JoinedMessageTest, PooledMessageReleasesItsParts) {
+    Message part = MakeMessage(7);
+    {
+        Message message = MakePooledMessage<JoinedMessage>();
+        auto& joined = message.Mut<JoinedMessage>();
+        joined.Resize(2);
+        joined.Set(1, part);
+        EXPECT_EQ(part.GetMetaData().messageId, joined.Get(1).GetMetaData().messageId);
+    }
+
+    // Back in the pool, the joined message holds nothing.
+    Message recycled = MakePooledMessage<JoinedMessage>();
+    EXPECT_EQ(recycled.Borrow<JoinedMessage>().Size(), 0u);
+}
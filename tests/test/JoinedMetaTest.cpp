@@ -0,0 +1,96 @@
+#include "PipelineTestUtils.hpp"
+#include "nexusflow/JoinedMessage.hpp"
+#include "nexusflow/ModuleFactory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace nexusflow;
+using namespace nexusflow::test;
+
+namespace {
+// Sends a single message, which the latest_value join then holds for every group.
+class JoinedMetaSecondary : public Module {
+public:
+    explicit JoinedMetaSecondary(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message&) override {
+        if (!m_isSent) {
+            Broadcast(MakeMessage(-1));
+            m_isSent = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+private:
+    bool m_isSent = false;
+};
+
+// Checks that the meta of every complete group is the primary's, the part at index 1.
+class JoinedMetaSink : public Module {
+public:
+    explicit JoinedMetaSink(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message& msg) override {
+        const auto& joined = msg.Borrow<JoinedMessage>();
+        if (!joined.Has(0) || !joined.Has(1)) {
+            return;
+        }
+        const auto& primaryMeta = joined.Get(1).GetMetaData();
+        const auto& secondaryMeta = joined.Get(0).GetMetaData();
+        if (msg.GetMetaData().correlationId == primaryMeta.correlationId &&
+            msg.GetMetaData().eventTime == primaryMeta.eventTime &&
+            msg.GetMetaData().correlationId != secondaryMeta.correlationId) {
+            ++primaryMetaCount;
+        }
+        ++groupCount;
+    }
+
+    static std::atomic<int> groupCount;
+    static std::atomic<int> primaryMetaCount;
+};
+
+std::atomic<int> JoinedMetaSink::groupCount{0};
+std::atomic<int> JoinedMetaSink::primaryMetaCount{0};
+
+using JoinedMetaPrimary = TickSource;
+} // namespace
+
+TEST(JoinedMetaTest, LatestValueGroupTakesThePrimaryMeta) {
+    NEXUSFLOW_REGISTER_MODULE(JoinedMetaSecondary);
+    NEXUSFLOW_REGISTER_MODULE(JoinedMetaPrimary);
+    NEXUSFLOW_REGISTER_MODULE(JoinedMetaSink);
+
+    // Inputs are indexed by name: the secondary "A" is input 0, the primary "B" input 1.
+    auto pipeline = CreatePipelineFromYaml(R"(graph:
+  name: JoinedMetaTest
+  modules:
+    - name: A
+      class: JoinedMetaSecondary
+    - name: B
+      class: JoinedMetaPrimary
+    - name: Sink
+      class: JoinedMetaSink
+      config:
+        syncInputs: true
+        joinMode: latest_value
+        joinPrimary: B
+  connections:
+    - from: A
+      to: Sink
+    - from: B
+      to: Sink
+)");
+    ASSERT_NE(pipeline, nullptr);
+    ASSERT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+    ASSERT_EQ(pipeline->Start(), ErrorCode::SUCCESS);
+
+    EXPECT_TRUE(WaitForCount(JoinedMetaSink::groupCount, 10));
+    pipeline->Stop();
+    pipeline->DeInit();
+    EXPECT_GT(JoinedMetaSink::groupCount.load(), 0);
+    EXPECT_EQ(JoinedMetaSink::primaryMetaCount.load(), JoinedMetaSink::groupCount.load());
+}
@@ -0,0 +1,96 @@
+#include "nexusflow/MessageBatch.hpp"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace nexusflow;
+
+namespace {
+
+struct Box {
+    float x0, y0, x1, y1;
+    float score;
+};
+
+// Scales every score of a batch in one tight loop over contiguous memory.
+class ScoreModule : public TypedBatchModule<Box> {
+public:
+    using TypedBatchModule<Box>::TypedBatchModule;
+
+    void ProcessTypedBatch(MessageBatch<Box>& batch) override {
+        ++batchCount;
+        for (const Box& box : batch.Values()) {
+            scoreSum += box.score;
+        }
+        for (size_t idx = 0; idx < batch.Size(); ++idx) {
+            forwardedIds.push_back(batch.GetMessage(idx).GetMetaData().messageId);
+        }
+    }
+
+    void Process(Message&) override { ++otherCount; }
+
+    int batchCount = 0;
+    int otherCount = 0;
+    float scoreSum = 0.0f;
+    std::vector<uint64_t> forwardedIds;
+};
+
+} // namespace
+
+TEST(MessageBatchTest, AssembleMixedBatch) {
+    std::vector<Message> messages;
+    messages.push_back(MakeMessage(Box{0, 0, 1, 1, 0.5f}));
+    messages.push_back(MakeMessage(std::string("not a box")));
+    messages.push_back(MakeMessage(Box{0, 0, 2, 2, 0.25f}));
+
+    MessageBatch<Box> batch;
+    batch.Assemble(messages);
+
+    ASSERT_EQ(batch.Size(), 2u);
+    EXPECT_EQ(batch.Items()[0], messages[0].BorrowPtr<Box>());
+    EXPECT_EQ(batch.Items()[1], messages[2].BorrowPtr<Box>());
+    ASSERT_EQ(batch.Values().size(), 2u);
+    EXPECT_FLOAT_EQ(batch.Values()[1].score, 0.25f);
+    ASSERT_EQ(batch.OtherIndices().size(), 1u);
+    EXPECT_EQ(batch.OtherIndices()[0], 1u);
+    EXPECT_EQ(&batch.GetMessage(1), &messages[2]);
+
+    // Re-assembling reuses the arrays.
+    messages.erase(messages.begin());
+    batch.Assemble(messages);
+    EXPECT_EQ(batch.Size(), 1u);
+    EXPECT_EQ(batch.OtherIndices()[0], 0u);
+}
+
+TEST(MessageBatchTest, NonTriviallyCopyablePayload) {
+    std::vector<Message> messages{MakeMessage(std::string("a")), MakeMessage(std::string("b"))};
+
+    MessageBatch<std::string> batch;
+    batch.Assemble(messages);
+    static_assert(!MessageBatch<std::string>::kIsContiguous, "std::string is not trivially copyable");
+    ASSERT_EQ(batch.Size(), 2u);
+    EXPECT_EQ(*batch.Items()[1], "b");
+}
+
+TEST(MessageBatchTest, TypedBatchModuleDispatch) {
+    ScoreModule module("Score");
+
+    std::vector<Message> messages;
+    messages.push_back(MakeMessage(Box{0, 0, 1, 1, 1.0f}));
+    messages.push_back(MakeMessage(42));
+    messages.push_back(MakeMessage(Box{0, 0, 1, 1, 2.0f}));
+    module.ProcessBatch(messages);
+
+    EXPECT_EQ(module.batchCount, 1);
+    EXPECT_EQ(module.otherCount, 1);
+    EXPECT_FLOAT_EQ(module.scoreSum, 3.0f);
+    ASSERT_EQ(module.forwardedIds.size(), 2u);
+    EXPECT_EQ(module.forwardedIds[1], messages[2].GetMetaData().messageId);
+
+    // A batch without any Box does not call ProcessTypedBatch.
+    std::vector<Message> others{MakeMessage(1)};
+    module.ProcessBatch(others);
+    EXPECT_EQ(module.batchCount, 1);
+    EXPECT_EQ(module.otherCount, 2);
+}
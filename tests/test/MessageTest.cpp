@@ -40,6 +40,28 @@ TEST_F(MessageTest, BasicFunctionality) {
     // Message ID and Timestamp will vary, so just check for non-default values.
     EXPECT_NE(meta.messageId, (uint64_t)-1); // A simple check.
     EXPECT_GT(meta.timestamp, 0);
+    EXPECT_GT(meta.ingressTime, 0u);
+    EXPECT_LE(meta.ingressTime, Message::GetMonotonicTimestamp());
+    EXPECT_EQ(meta.correlationId, meta.messageId);
+}
+
+TEST_F(MessageTest, DerivedMessageInheritsCorrelation) {
+    Message frame = MakeMessage(std::string("frame"), "Decoder");
+    frame.MetaData().streamId = 3;
+    frame.MetaData().eventTime = 42;
+
+    Message result = MakeMessageFrom(frame, 7, "Detector");
+    const auto& meta = result.GetMetaData();
+    EXPECT_NE(meta.messageId, frame.GetMetaData().messageId);
+    EXPECT_EQ(meta.correlationId, frame.GetMetaData().messageId);
+    EXPECT_EQ(meta.sourceName, "Detector");
+    EXPECT_EQ(meta.streamId, 3u);
+    EXPECT_EQ(meta.eventTime, 42u);
+    EXPECT_EQ(meta.ingressTime, frame.GetMetaData().ingressTime);
+
+    // Derivation chains keep the original correlation id.
+    Message pooled = MakePooledMessageFrom<std::string>(result);
+    EXPECT_EQ(pooled.GetMetaData().correlationId, frame.GetMetaData().messageId);
 }
 
 // --- Data Access Tests ---
@@ -215,4 +237,126 @@ TEST_F(MessageTest, Multithreading) {
 
     // If the test completes without crashing, it's a good indication of thread safety.
     SUCCEED();
-}
\ No newline at end of file
+}
+// --- Attachment Tests ---
+TEST_F(MessageTest, AttachmentAccess) {
+    auto msg = MakeMessage(42, "Detector");
+    EXPECT_FALSE(msg.HasAttachments());
+
+    msg.SetAttachment("boxes", std::vector<int>{1, 2, 3});
+    msg.SetAttachment("label", std::string("person"));
+
+    EXPECT_TRUE(msg.HasAttachment("boxes"));
+    EXPECT_TRUE(msg.HasAttachment<std::vector<int>>("boxes"));
+    EXPECT_FALSE(msg.HasAttachment<std::string>("boxes"));
+    EXPECT_FALSE(msg.HasAttachment("missing"));
+
+    ASSERT_NE(msg.BorrowAttachmentPtr<std::string>("label"), nullptr);
+    EXPECT_EQ(*msg.BorrowAttachmentPtr<std::string>("label"), "person");
+    EXPECT_EQ(msg.BorrowAttachmentPtr<int>("label"), nullptr);
+    EXPECT_EQ(msg.MutAttachmentPtr<int>("missing"), nullptr);
+
+    // Replacing keeps a single entry, removing drops it.
+    msg.SetAttachment("label", std::string("head"));
+    EXPECT_EQ(*msg.BorrowAttachmentPtr<std::string>("label"), "head");
+    EXPECT_TRUE(msg.RemoveAttachment("label"));
+    EXPECT_FALSE(msg.RemoveAttachment("label"));
+    EXPECT_FALSE(msg.HasAttachment("label"));
+
+    // The main payload is independent of the attachments.
+    EXPECT_EQ(msg.Borrow<int>(), 42);
+}
+
+TEST_F(MessageTest, AttachmentCopyOnWriteIsPerPart) {
+    auto original = MakeMessage(std::string("frame"));
+    original.SetAttachment("frame", std::vector<int>(1024, 7));
+    original.SetAttachment("boxes", std::vector<int>{});
+
+    auto branchA = original;
+    auto branchB = original;
+
+    // Each branch writes its own boxes, the frame attachment and the payload stay shared.
+    branchA.MutAttachmentPtr<std::vector<int>>("boxes")->push_back(1);
+    branchB.MutAttachmentPtr<std::vector<int>>("boxes")->push_back(2);
+
+    EXPECT_TRUE(original.BorrowAttachmentPtr<std::vector<int>>("boxes")->empty());
+    EXPECT_EQ(branchA.BorrowAttachmentPtr<std::vector<int>>("boxes")->at(0), 1);
+    EXPECT_EQ(branchB.BorrowAttachmentPtr<std::vector<int>>("boxes")->at(0), 2);
+
+    const auto* frame = original.BorrowAttachmentPtr<std::vector<int>>("frame");
+    EXPECT_EQ(branchA.BorrowAttachmentPtr<std::vector<int>>("frame"), frame);
+    EXPECT_EQ(branchB.BorrowAttachmentPtr<std::vector<int>>("frame"), frame);
+    EXPECT_EQ(&branchA.Borrow<std::string>(), &original.Borrow<std::string>());
+
+    // A deep Clone duplicates the attachments as well.
+    auto clone = original.Clone();
+    EXPECT_NE(clone.BorrowAttachmentPtr<std::vector<int>>("frame"), frame);
+    EXPECT_EQ(clone.BorrowAttachmentPtr<std::vector<int>>("frame")->size(), 1024u);
+}
+
+// --- Pooled Message Tests ---
+namespace {
+struct PooledPayload {
+    std::vector<int> values;
+    int resetCount = 0;
+
+    void Reset() {
+        values.clear(); // Keeps the capacity.
+        ++resetCount;
+    }
+};
+} // namespace
+
+TEST_F(MessageTest, PooledMessageRecyclesPayload) {
+    const int* storage = nullptr;
+    int resetCount = 0;
+    {
+        auto msg = MakePooledMessage<PooledPayload>("Detector");
+        EXPECT_TRUE(msg.HasType<PooledPayload>());
+        EXPECT_EQ(msg.GetMetaData().sourceName, "Detector");
+
+        auto* payload = msg.MutPtr<PooledPayload>();
+        ASSERT_NE(payload, nullptr);
+        payload->values.assign(100, 1);
+        storage = payload->values.data();
+        resetCount = payload->resetCount;
+
+        auto shared = msg; // Released together with msg, no COW.
+    }
+
+    // The recycled object comes back reset, with its capacity intact.
+    auto msg = MakePooledMessage<PooledPayload>();
+    const auto& payload = msg.Borrow<PooledPayload>();
+    EXPECT_TRUE(payload.values.empty());
+    EXPECT_GE(payload.values.capacity(), 100u);
+    EXPECT_EQ(payload.values.data(), storage);
+    EXPECT_EQ(payload.resetCount, resetCount + 1);
+
+    // COW on a pooled message still works, the copy is a regular allocation.
+    auto copy = msg;
+    copy.Mut<PooledPayload>().values.push_back(5);
+    EXPECT_TRUE(msg.Borrow<PooledPayload>().values.empty());
+}
+
+// --- Type Id Tests ---
+TEST_F(MessageTest, TypeIdChecks) {
+    static_assert(GetTypeId<int>() == GetTypeId<const int>(), "cv-qualifiers must be ignored");
+    EXPECT_NE(GetTypeId<int>(), GetTypeId<double>());
+    EXPECT_NE(GetTypeId<int>(), kInvalidTypeId);
+
+    auto msg = MakeMessage(std::string("payload"));
+    EXPECT_TRUE(msg.HasType<std::string>());
+    EXPECT_TRUE(msg.HasType<const std::string>());
+
+    // A moved-from message is empty and must not claim a type.
+    Message moved = std::move(msg);
+    EXPECT_TRUE(moved.HasType<std::string>());
+    EXPECT_FALSE(msg.HasType<std::string>());
+    EXPECT_EQ(msg.BorrowPtr<std::string>(), nullptr);
+
+    Message assigned;
+    assigned = std::move(moved);
+    EXPECT_FALSE(moved.HasType<std::string>());
+    EXPECT_EQ(assigned.Borrow<std::string>(), "payload");
+    EXPECT_TRUE(assigned.Clone().HasType<std::string>());
+}
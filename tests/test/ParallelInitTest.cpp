@@ -0,0 +1,96 @@
+#include "nexusflow/Pipeline.hpp"
+#include "nexusflow/PipelineBuilder.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace nexusflow;
+
+namespace {
+struct InitTracker {
+    std::atomic<int> activeCount{0};
+    std::atomic<int> maxActiveCount{0};
+    std::atomic<int> initCount{0};
+};
+
+enum class InitOutcome { SUCCESS, FAILURE, THROW };
+
+// Stands in for a module loading a model in Init.
+class SlowInitModule : public Module {
+public:
+    SlowInitModule(std::string name, InitTracker& tracker, InitOutcome outcome = InitOutcome::SUCCESS)
+        : Module(std::move(name)), m_tracker(tracker), m_outcome(outcome) {}
+
+    ErrorCode Init() override {
+        const int activeCount = ++m_tracker.activeCount;
+        int maxActiveCount = m_tracker.maxActiveCount.load();
+        while (activeCount > maxActiveCount && !m_tracker.maxActiveCount.compare_exchange_weak(maxActiveCount, activeCount)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        --m_tracker.activeCount;
+        ++m_tracker.initCount;
+        if (m_outcome == InitOutcome::THROW) {
+            throw std::runtime_error("Model file not found");
+        }
+        return m_outcome == InitOutcome::FAILURE ? ErrorCode::FAILURE : ErrorCode::SUCCESS;
+    }
+
+    void Process(Message&) override {}
+
+private:
+    InitTracker& m_tracker;
+    InitOutcome m_outcome;
+};
+
+// A source feeding `detectorCount` detectors, which are one level.
+std::unique_ptr<Pipeline> BuildPipeline(InitTracker& tracker, int detectorCount,
+                                        InitOutcome lastOutcome = InitOutcome::SUCCESS) {
+    PipelineBuilder builder;
+    builder.AddModule(std::make_shared<SlowInitModule>("Source", tracker));
+    for (int idx = 0; idx < detectorCount; ++idx) {
+        const std::string name = "Detector" + std::to_string(idx);
+        builder.AddModule(std::make_shared<SlowInitModule>(name, tracker, idx == detectorCount - 1 ? lastOutcome : InitOutcome::SUCCESS));
+        builder.Connect("Source", name);
+    }
+    return builder.Build();
+}
+} // namespace
+
+TEST(ParallelInitTest, LevelIsInitializedConcurrently) {
+    InitTracker tracker;
+    auto pipeline = BuildPipeline(tracker, 6);
+    ASSERT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+    EXPECT_EQ(tracker.initCount.load(), 7);
+    EXPECT_EQ(tracker.maxActiveCount.load(), 6); // The source is a level of its own.
+    pipeline->DeInit();
+}
+
+TEST(ParallelInitTest, ParallelismIsLimited) {
+    InitTracker tracker;
+    auto pipeline = BuildPipeline(tracker, 6);
+    pipeline->SetInitParallelism(2);
+    ASSERT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+    EXPECT_EQ(tracker.initCount.load(), 7);
+    EXPECT_EQ(tracker.maxActiveCount.load(), 2);
+    pipeline->DeInit();
+}
+
+TEST(ParallelInitTest, FailureIsReportedAfterTheLevel) {
+    InitTracker tracker;
+    auto pipeline = BuildPipeline(tracker, 3, InitOutcome::FAILURE);
+    EXPECT_EQ(pipeline->Init(), ErrorCode::FAILURE);
+    EXPECT_EQ(tracker.initCount.load(), 4);
+}
+
+TEST(ParallelInitTest, ExceptionIsReportedAsFailure) {
+    InitTracker tracker;
+    auto pipeline = BuildPipeline(tracker, 3, InitOutcome::THROW);
+    EXPECT_EQ(pipeline->Init(), ErrorCode::FAILURE);
+    EXPECT_EQ(tracker.initCount.load(), 4);
+}
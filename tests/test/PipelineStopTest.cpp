@@ -0,0 +1,130 @@
+#include "PipelineTestUtils.hpp"
+#include "module/WindowAggregateModule.hpp"
+#include "nexusflow/JoinedMessage.hpp"
+#include "nexusflow/ModuleFactory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace nexusflow;
+using namespace nexusflow::test;
+
+namespace {
+// A fast source feeding a slow stage, whose input queue is always full.
+struct StopTest {
+    std::shared_ptr<SlowStage> stage = std::make_shared<SlowStage>("Stage");
+    std::shared_ptr<CountingSink> sink = std::make_shared<CountingSink>("Sink");
+    TestPipeline pipeline{{std::make_shared<TickSource>("Source", std::chrono::microseconds(200)), stage, sink},
+                          {{"Source", "Stage"}, {"Stage", "Sink"}}};
+};
+
+// Counts the groups its join hands over.
+class StopJoinSink : public Module {
+public:
+    explicit StopJoinSink(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message& msg) override {
+        if (msg.HasType<JoinedMessage>()) {
+            ++groupCount;
+        }
+    }
+
+    static std::atomic<int> groupCount;
+};
+
+std::atomic<int> StopJoinSink::groupCount{0};
+
+using StopTickSource = TickSource;
+
+// Two sources whose messages never share a correlation id, so every group the join holds stays partial.
+std::unique_ptr<Pipeline> CreateJoinPipeline(const std::string& joinPolicy) {
+    NEXUSFLOW_REGISTER_MODULE(StopTickSource);
+    NEXUSFLOW_REGISTER_MODULE(StopJoinSink);
+    return CreatePipelineFromYaml(R"(graph:
+  name: StopJoinTest
+  modules:
+    - name: A
+      class: StopTickSource
+    - name: B
+      class: StopTickSource
+    - name: Join
+      class: StopJoinSink
+      config:
+        syncInputs: true
+        joinPolicy: )" + joinPolicy + R"(
+  connections:
+    - from: A
+      to: Join
+    - from: B
+      to: Join
+)");
+}
+
+// Runs the pipeline until the source "A" sent a few messages, then stops it with a drain.
+size_t RunAndDrain(Pipeline& pipeline) {
+    EXPECT_EQ(pipeline.Init(), ErrorCode::SUCCESS);
+    auto sentCount = std::make_shared<std::atomic<int>>(0);
+    pipeline.AttachTap("A", [sentCount](const Message&) { ++*sentCount; });
+    EXPECT_EQ(pipeline.Start(), ErrorCode::SUCCESS);
+    EXPECT_TRUE(WaitForCount(*sentCount, 5));
+
+    size_t discardedCount = 0;
+    EXPECT_EQ(pipeline.Stop(true, std::chrono::seconds(5), &discardedCount), ErrorCode::SUCCESS);
+    pipeline.DeInit();
+    return discardedCount;
+}
+} // namespace
+
+TEST(PipelineStopTest, DrainProcessesMessagesInFlight) {
+    StopTest test;
+    ASSERT_TRUE(WaitForCount(test.stage->forwardedCount, 5));
+
+    size_t discardedCount = 1;
+    EXPECT_EQ(test.pipeline.Stop(true, std::chrono::seconds(5), &discardedCount), ErrorCode::SUCCESS);
+    EXPECT_EQ(discardedCount, 0u);
+    EXPECT_GT(test.sink->receivedCount.load(), 0);
+    EXPECT_EQ(test.sink->receivedCount.load(), test.stage->forwardedCount.load());
+}
+
+TEST(PipelineStopTest, DeadlineDiscardsWhatIsLeft) {
+    StopTest test;
+    ASSERT_TRUE(WaitForCount(test.stage->forwardedCount, 5));
+
+    size_t discardedCount = 0;
+    test.pipeline.Stop(true, std::chrono::milliseconds(0), &discardedCount);
+    EXPECT_GT(discardedCount, 0u);
+}
+
+TEST(PipelineStopTest, DrainClosesOpenWindows) {
+    auto stage = std::make_shared<SlowStage>("Stage");
+    auto window = std::make_shared<WindowAggregateModule>("Window");
+    Config config;
+    config.Add("windowBy", std::string("count"));
+    config.Add("windowSize", 1000000); // Never full, only the drain closes it.
+    ASSERT_EQ(window->Configure(config), ErrorCode::SUCCESS);
+    auto sink = std::make_shared<CountingSink>("Sink");
+    TestPipeline pipeline{{std::make_shared<TickSource>("Source"), stage, window, sink},
+                          {{"Source", "Stage"}, {"Stage", "Window"}, {"Window", "Sink"}}};
+    ASSERT_TRUE(WaitForCount(stage->forwardedCount, 3));
+
+    EXPECT_EQ(pipeline.Stop(), ErrorCode::SUCCESS);
+    EXPECT_EQ(sink->receivedCount.load(), 1);
+}
+
+TEST(PipelineStopTest, DrainEmitsPartialJoinGroups) {
+    StopJoinSink::groupCount = 0;
+    auto pipeline = CreateJoinPipeline("emit_partial_on_timeout");
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_EQ(RunAndDrain(*pipeline), 0u);
+    EXPECT_GT(StopJoinSink::groupCount.load(), 0);
+}
+
+TEST(PipelineStopTest, DrainCountsDroppedJoinGroups) {
+    StopJoinSink::groupCount = 0;
+    auto pipeline = CreateJoinPipeline("all");
+    ASSERT_NE(pipeline, nullptr);
+    EXPECT_GT(RunAndDrain(*pipeline), 0u);
+    EXPECT_EQ(StopJoinSink::groupCount.load(), 0);
+}
@@ -0,0 +1,145 @@
+#ifndef NEXUSFLOW_PIPELINE_TEST_UTILS_HPP
+#define NEXUSFLOW_PIPELINE_TEST_UTILS_HPP
+
+#include "nexusflow/Pipeline.hpp"
+#include "nexusflow/PipelineBuilder.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// The modules and the fixture shared by the tests running a whole pipeline.
+namespace nexusflow { namespace test {
+
+// Sends the int 1 every `interval`.
+class TickSource : public Module {
+public:
+    explicit TickSource(std::string name, std::chrono::microseconds interval = std::chrono::milliseconds(1))
+        : Module(std::move(name)), m_interval(interval) {}
+
+    void Process(Message&) override {
+        Broadcast(MakeMessage(1));
+        std::this_thread::sleep_for(m_interval);
+    }
+
+private:
+    std::chrono::microseconds m_interval;
+};
+
+// Slower than the sources, so there are always messages in flight through it.
+class SlowStage : public Module {
+public:
+    explicit SlowStage(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message& msg) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ++forwardedCount;
+        Broadcast(msg);
+    }
+
+    std::atomic<int> forwardedCount{0};
+};
+
+// Counts the messages it receives and keeps the last int among them.
+class CountingSink : public Module {
+public:
+    explicit CountingSink(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message& msg) override {
+        if (msg.HasType<int>()) {
+            lastValue = msg.Borrow<int>();
+        }
+        ++receivedCount;
+    }
+
+    std::atomic<int> receivedCount{0};
+    std::atomic<int> lastValue{0};
+};
+
+// Polls until `condition` holds, for at most 5 s. Returns whether it held.
+template <typename Condition>
+bool WaitFor(Condition condition) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+inline bool WaitForCount(const std::atomic<int>& count, int minCount) {
+    return WaitFor([&count, minCount]() { return count.load() >= minCount; });
+}
+
+// Builds a pipeline from a YAML graph, for the settings only a module's config sets, such as the join mode.
+inline std::unique_ptr<Pipeline> CreatePipelineFromYaml(const std::string& yaml) {
+    const std::string configPath = testing::TempDir() + "nexusflow_test_pipeline.yaml";
+    std::ofstream(configPath) << yaml;
+    auto pipeline = Pipeline::CreateFromYaml(configPath);
+    std::remove(configPath.c_str());
+    return pipeline;
+}
+
+/**
+ * @brief Builds and initializes a pipeline, and starts it unless told otherwise. The pipeline is
+ * stopped, unless `Stop()` was called, and de-initialized when the fixture goes out of scope.
+ */
+class TestPipeline {
+public:
+    TestPipeline(const std::vector<std::shared_ptr<Module>>& modules,
+                 const std::vector<std::pair<std::string, std::string>>& connections, bool isStarted = true) {
+        PipelineBuilder builder;
+        for (const auto& module : modules) {
+            builder.AddModule(module);
+        }
+        for (const auto& connection : connections) {
+            builder.Connect(connection.first, connection.second);
+        }
+        pipeline = builder.Build();
+        EXPECT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+        if (isStarted) {
+            Start();
+        }
+    }
+
+    ~TestPipeline() {
+        if (m_isRunning) {
+            pipeline->Stop();
+        }
+        pipeline->DeInit();
+    }
+
+    TestPipeline(const TestPipeline&) = delete;
+    TestPipeline& operator=(const TestPipeline&) = delete;
+
+    void Start() {
+        EXPECT_EQ(pipeline->Start(), ErrorCode::SUCCESS);
+        m_isRunning = true;
+    }
+
+    ErrorCode Stop(bool drain = true, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000),
+                   size_t* discardedCount = nullptr) {
+        m_isRunning = false;
+        return pipeline->Stop(drain, timeout, discardedCount);
+    }
+
+    Pipeline* operator->() const { return pipeline.get(); }
+
+    std::unique_ptr<Pipeline> pipeline;
+
+private:
+    bool m_isRunning = false;
+};
+
+}} // namespace nexusflow::test
+
+#endif // NEXUSFLOW_PIPELINE_TEST_UTILS_HPP
@@ -0,0 +1,131 @@
+#include "PipelineTestUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace nexusflow;
+using namespace nexusflow::test;
+
+namespace {
+// Scales its input by a factor that can be changed while the pipeline runs.
+class ScaleStage : public Module {
+public:
+    explicit ScaleStage(std::string name) : Module(std::move(name)) {}
+
+    ErrorCode OnReconfigure(const Config& config) override {
+        const int factor = config.GetValueOrDefault<int>("factor", 0);
+        if (factor <= 0) {
+            ++rejectedCount;
+            return ErrorCode::FAILURE;
+        }
+        m_factor = factor;
+        return ErrorCode::SUCCESS;
+    }
+
+    void Process(Message& msg) override { Broadcast(MakeMessage(msg.Borrow<int>() * m_factor)); }
+
+    std::atomic<int> rejectedCount{0};
+
+private:
+    int m_factor = 1;
+};
+
+struct ScalePipeline {
+    std::shared_ptr<ScaleStage> scale = std::make_shared<ScaleStage>("Scale");
+    std::shared_ptr<CountingSink> sink = std::make_shared<CountingSink>("Sink");
+    TestPipeline pipeline;
+
+    explicit ScalePipeline(bool isStarted = true)
+        : pipeline({std::make_shared<TickSource>("Source"), scale, sink}, {{"Source", "Scale"}, {"Scale", "Sink"}}, isStarted) {}
+
+    bool WaitForValue(int value) const {
+        return WaitFor([this, value]() { return sink->lastValue.load() == value; });
+    }
+};
+
+// Runs as a source that sends nothing, so the stage after it waits out every batch timeout.
+class IdleSource : public Module {
+public:
+    explicit IdleSource(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message&) override { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+};
+
+void WriteGraphFile(const std::string& path, int factor) {
+    std::ofstream file(path);
+    file << "graph:\n"
+            "  modules:\n"
+            "    - name: Source\n"
+            "      class: TickSource\n"
+            "    - name: Scale\n"
+            "      class: ScaleStage\n"
+            "      config:\n"
+            "        factor: "
+         << factor << "\n";
+}
+} // namespace
+
+TEST(ReconfigureTest, RunningModuleReceivesNewConfig) {
+    ScalePipeline test;
+    EXPECT_TRUE(test.WaitForValue(1));
+
+    Config config;
+    config.Add("factor", 3);
+    EXPECT_EQ(test.pipeline->Reconfigure("Scale", config), ErrorCode::SUCCESS);
+    EXPECT_TRUE(test.WaitForValue(3));
+
+    // A rejected config leaves the previous one in place.
+    Config invalid;
+    invalid.Add("factor", -1);
+    EXPECT_EQ(test.pipeline->Reconfigure("Scale", invalid), ErrorCode::SUCCESS);
+    ASSERT_TRUE(WaitFor([&test]() { return test.scale->rejectedCount.load() == 1; }));
+    // Messages scaled after the rejection still reach the sink scaled by 3.
+    const int receivedCount = test.sink->receivedCount.load();
+    ASSERT_TRUE(WaitForCount(test.sink->receivedCount, receivedCount + 10));
+    EXPECT_EQ(test.sink->lastValue.load(), 3);
+}
+
+TEST(ReconfigureTest, IdleModuleAppliesConfigWithoutWaitingForItsBatch) {
+    auto scale = std::make_shared<ScaleStage>("Scale");
+    TestPipeline pipeline{{std::make_shared<IdleSource>("Source"), scale}, {{"Source", "Scale"}}};
+
+    // The batch timeout is 100 ms; a posted config ends the wait for the batch.
+    Config invalid;
+    invalid.Add("factor", -1);
+    for (int attempt = 1; attempt <= 5; ++attempt) {
+        const auto startTime = std::chrono::steady_clock::now();
+        ASSERT_EQ(pipeline->Reconfigure("Scale", invalid), ErrorCode::SUCCESS);
+        ASSERT_TRUE(WaitFor([&scale, attempt]() { return scale->rejectedCount.load() == attempt; }));
+        EXPECT_LT(std::chrono::steady_clock::now() - startTime, std::chrono::milliseconds(50));
+    }
+}
+
+TEST(ReconfigureTest, UnknownModuleFails) {
+    ScalePipeline test(false);
+    EXPECT_EQ(test.pipeline->Reconfigure("Missing", Config()), ErrorCode::FAILURE);
+}
+
+TEST(ReconfigureTest, WatchedFileChangeReconfigures) {
+    const std::string path = "reconfigure_test_graph.yaml";
+    WriteGraphFile(path, 1);
+
+    ScalePipeline test;
+    ASSERT_EQ(test.pipeline->WatchConfigFile(path, std::chrono::milliseconds(10)), ErrorCode::SUCCESS);
+    EXPECT_TRUE(test.WaitForValue(1));
+
+    WriteGraphFile(path, 5);
+    EXPECT_TRUE(test.WaitForValue(5));
+
+    test.pipeline->StopWatchingConfigFile();
+    std::remove(path.c_str());
+}
+
+TEST(ReconfigureTest, WatchingMissingFileFails) {
+    ScalePipeline test(false);
+    EXPECT_NE(test.pipeline->WatchConfigFile("no_such_graph.yaml"), ErrorCode::SUCCESS);
+}
@@ -0,0 +1,102 @@
+#include "nexusflow/Pipeline.hpp"
+#include "nexusflow/PipelineBuilder.hpp"
+#include "nexusflow/Tap.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace nexusflow;
+
+namespace {
+class CounterSource : public Module {
+public:
+    explicit CounterSource(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message&) override {
+        Broadcast(MakeMessage(m_next++));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+private:
+    int m_next = 0;
+};
+
+class NullSink : public Module {
+public:
+    explicit NullSink(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message&) override {}
+};
+
+std::unique_ptr<Pipeline> BuildPipeline() {
+    PipelineBuilder builder;
+    builder.AddModule(std::make_shared<CounterSource>("Source")).AddModule(std::make_shared<NullSink>("Sink")).Connect("Source", "Sink");
+    return builder.Build();
+}
+} // namespace
+
+TEST(TapTest, BufferTapObservesOutput) {
+    auto pipeline = BuildPipeline();
+    ASSERT_NE(pipeline, nullptr);
+    ASSERT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+
+    EXPECT_EQ(pipeline->AttachTap("NoSuchModule", TapBuffer::Create(4)), kInvalidTapId);
+
+    auto buffer = TapBuffer::Create(4);
+    TapId tapId = pipeline->AttachTap("Source", buffer);
+    ASSERT_NE(tapId, kInvalidTapId);
+
+    pipeline->Start();
+    Message first;
+    ASSERT_TRUE(buffer->WaitAndPopFor(first, std::chrono::seconds(2)));
+    EXPECT_TRUE(first.HasType<int>());
+
+    // The tap never blocks the source, a full buffer drops and counts.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(buffer->GetSize(), 4u);
+    EXPECT_GT(buffer->GetDroppedCount(), 0u);
+
+    EXPECT_EQ(pipeline->DetachTap(tapId), ErrorCode::SUCCESS);
+    EXPECT_EQ(pipeline->DetachTap(tapId), ErrorCode::FAILURE);
+    uint64_t dropped = buffer->GetDroppedCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(buffer->GetDroppedCount(), dropped);
+
+    pipeline->Stop();
+    pipeline->DeInit();
+}
+
+TEST(TapTest, SampledCallbackTap) {
+    auto pipeline = BuildPipeline();
+    ASSERT_NE(pipeline, nullptr);
+    ASSERT_EQ(pipeline->Init(), ErrorCode::SUCCESS);
+
+    std::atomic<int> calls{0};
+    std::atomic<bool> sampled{true};
+    TapId tapId = pipeline->AttachTap(
+        "Source",
+        [&calls, &sampled](const Message& msg) {
+            // Every 10th message, starting with the first.
+            if (msg.Borrow<int>() % 10 != 0) {
+                sampled = false;
+            }
+            ++calls;
+        },
+        10);
+    ASSERT_NE(tapId, kInvalidTapId);
+
+    pipeline->Start();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (calls.load() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_GE(calls.load(), 3);
+    EXPECT_TRUE(sampled.load());
+
+    EXPECT_EQ(pipeline->DetachTap(tapId), ErrorCode::SUCCESS);
+    pipeline->Stop();
+    pipeline->DeInit();
+}
@@ -0,0 +1,129 @@
+#include "PipelineTestUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+using namespace nexusflow;
+using namespace nexusflow::test;
+
+namespace {
+// Counts its Init and DeInit calls; Init fails if asked to.
+class LifecycleModule : public Module {
+public:
+    LifecycleModule(std::string name, bool isInitFailing) : Module(std::move(name)), m_isInitFailing(isInitFailing) {}
+
+    ErrorCode Init() override {
+        ++initCount;
+        return m_isInitFailing ? ErrorCode::FAILURE : ErrorCode::SUCCESS;
+    }
+
+    ErrorCode DeInit() override {
+        ++deInitCount;
+        return ErrorCode::SUCCESS;
+    }
+
+    void Process(Message&) override {}
+
+    std::atomic<int> initCount{0};
+    std::atomic<int> deInitCount{0};
+
+private:
+    bool m_isInitFailing;
+};
+
+// A source feeding a sink through a stage slower than it, so there are always messages in flight.
+struct TopologyTest {
+    std::shared_ptr<CountingSink> sink = std::make_shared<CountingSink>("Sink");
+    TestPipeline pipeline{{std::make_shared<TickSource>("Source", std::chrono::microseconds(500)),
+                           std::make_shared<SlowStage>("Stage"), sink},
+                          {{"Source", "Stage"}, {"Stage", "Sink"}}};
+};
+} // namespace
+
+TEST(TopologyChangeTest, BranchAddedAndRemovedWhileRunning) {
+    TopologyTest test;
+    ASSERT_TRUE(WaitForCount(test.sink->receivedCount, 5));
+
+    auto branchStage = std::make_shared<SlowStage>("BranchStage");
+    auto branchSink = std::make_shared<CountingSink>("BranchSink");
+    ASSERT_EQ(test.pipeline->AddSubgraph({branchStage, branchSink}, {{"Source", "BranchStage"}, {"BranchStage", "BranchSink"}}),
+              ErrorCode::SUCCESS);
+    EXPECT_TRUE(WaitForCount(branchSink->receivedCount, 5));
+
+    // The removed branch is drained: everything its stage forwarded reached its sink.
+    size_t discardedCount = 1;
+    ASSERT_EQ(test.pipeline->RemoveSubgraph({"BranchStage", "BranchSink"}, std::chrono::seconds(5), &discardedCount),
+              ErrorCode::SUCCESS);
+    EXPECT_EQ(discardedCount, 0u);
+    EXPECT_EQ(branchSink->receivedCount.load(), branchStage->forwardedCount.load());
+
+    // The original stream kept flowing.
+    const int receivedCount = test.sink->receivedCount.load();
+    EXPECT_TRUE(WaitForCount(test.sink->receivedCount, receivedCount + 5));
+}
+
+TEST(TopologyChangeTest, ConnectAndDisconnectWhileRunning) {
+    TopologyTest test;
+    auto tapSink = std::make_shared<CountingSink>("TapSink");
+    ASSERT_EQ(test.pipeline->AddSubgraph({tapSink}, {}), ErrorCode::SUCCESS);
+
+    // A module without inputs runs as a source, it cannot gain inputs while it runs.
+    EXPECT_EQ(test.pipeline->Connect("Stage", "TapSink"), ErrorCode::FAILURE);
+    ASSERT_EQ(test.pipeline->RemoveModule("TapSink"), ErrorCode::SUCCESS);
+    // As a source it counted the empty messages its loop processed; only what arrives from now on went through the edges.
+    const int sourceLoopCount = tapSink->receivedCount.load();
+
+    ASSERT_EQ(test.pipeline->AddSubgraph({tapSink}, {{"Source", "TapSink"}}), ErrorCode::SUCCESS);
+    ASSERT_EQ(test.pipeline->Connect("Stage", "TapSink"), ErrorCode::SUCCESS);
+    EXPECT_TRUE(WaitForCount(tapSink->receivedCount, sourceLoopCount + 10));
+
+    ASSERT_EQ(test.pipeline->Disconnect("Source", "TapSink"), ErrorCode::SUCCESS);
+    ASSERT_EQ(test.pipeline->Disconnect("Stage", "TapSink"), ErrorCode::SUCCESS);
+    // Disconnect returns once the module processed what was sent to it; the stream goes on without it.
+    const int receivedCount = tapSink->receivedCount.load();
+    const int sinkCount = test.sink->receivedCount.load();
+    ASSERT_TRUE(WaitForCount(test.sink->receivedCount, sinkCount + 10));
+    EXPECT_EQ(tapSink->receivedCount.load(), receivedCount);
+
+    // Without inputs it still runs its input loop, so it can be connected again.
+    ASSERT_EQ(test.pipeline->Connect("Source", "TapSink"), ErrorCode::SUCCESS);
+    EXPECT_TRUE(WaitForCount(tapSink->receivedCount, receivedCount + 5));
+}
+
+TEST(TopologyChangeTest, InvalidChangesLeaveThePipelineUntouched) {
+    TopologyTest test;
+    EXPECT_EQ(test.pipeline->Connect("Sink", "Stage"), ErrorCode::INVALID_ARGUMENT); // A cycle.
+    EXPECT_EQ(test.pipeline->Connect("Source", "Stage"), ErrorCode::INVALID_ARGUMENT); // Connected already.
+    EXPECT_EQ(test.pipeline->Connect("Source", "Missing"), ErrorCode::INVALID_ARGUMENT);
+    EXPECT_EQ(test.pipeline->Disconnect("Source", "Sink"), ErrorCode::INVALID_ARGUMENT);
+    EXPECT_EQ(test.pipeline->RemoveModule("Missing"), ErrorCode::INVALID_ARGUMENT);
+    EXPECT_EQ(test.pipeline->AddSubgraph({std::make_shared<CountingSink>("Sink")}, {}), ErrorCode::INVALID_ARGUMENT);
+    EXPECT_EQ(test.pipeline->AddSubgraph({std::make_shared<CountingSink>("Other")}, {{"Other", "Missing"}}),
+              ErrorCode::INVALID_ARGUMENT);
+
+    const int receivedCount = test.sink->receivedCount.load();
+    EXPECT_TRUE(WaitForCount(test.sink->receivedCount, receivedCount + 5));
+}
+
+TEST(TopologyChangeTest, FailedInitRollsTheSubgraphBack) {
+    TopologyTest test;
+    auto stage = std::make_shared<LifecycleModule>("NewStage", false);
+    auto sink = std::make_shared<LifecycleModule>("NewSink", true);
+    auto unreached = std::make_shared<LifecycleModule>("Unreached", false);
+    EXPECT_EQ(test.pipeline->AddSubgraph({stage, sink, unreached}, {{"Source", "NewStage"}, {"NewStage", "NewSink"},
+                                                                    {"NewSink", "Unreached"}, {"NewStage", "Sink"}}),
+              ErrorCode::FAILURE);
+
+    // Only the module that initialized is de-initialized; the one after the failed level never ran Init.
+    EXPECT_EQ(stage->deInitCount.load(), 1);
+    EXPECT_EQ(sink->deInitCount.load(), 0);
+    EXPECT_EQ(unreached->initCount.load(), 0);
+    EXPECT_EQ(unreached->deInitCount.load(), 0);
+
+    // The pipeline is as before: the names are free again, and the stream keeps flowing.
+    EXPECT_EQ(test.pipeline->AddSubgraph({std::make_shared<CountingSink>("NewSink")}, {{"Stage", "NewSink"}}),
+              ErrorCode::SUCCESS);
+    const int receivedCount = test.sink->receivedCount.load();
+    EXPECT_TRUE(WaitForCount(test.sink->receivedCount, receivedCount + 5));
+}
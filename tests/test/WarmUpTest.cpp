@@ -0,0 +1,83 @@
+#include "PipelineTestUtils.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace nexusflow;
+using namespace nexusflow::test;
+
+namespace {
+// Sends synthetic samples while warming up, and counts up once live; the watermarks follow the counters.
+class CountingSource : public Module {
+public:
+    explicit CountingSource(std::string name) : Module(std::move(name)) {}
+
+    void WarmUp() override {
+        ++warmUpCount;
+        Broadcast(MakeMessage(-1));
+        EmitWatermark(1000 + warmUpCount);
+    }
+
+    void Process(Message&) override {
+        ++processCount;
+        Broadcast(MakeMessage(processCount.load()));
+        EmitWatermark(processCount);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::atomic<int> warmUpCount{0};
+    std::atomic<int> processCount{0};
+};
+
+class ForwardingStage : public Module {
+public:
+    explicit ForwardingStage(std::string name) : Module(std::move(name)) {}
+
+    void Process(Message& msg) override {
+        ++(IsWarmingUp() ? warmUpCount : processCount);
+        Broadcast(msg);
+    }
+
+    void OnWatermark(uint64_t eventTime) override { lastWatermark = eventTime; }
+
+    std::atomic<int> warmUpCount{0};
+    std::atomic<int> processCount{0};
+    std::atomic<uint64_t> lastWatermark{0};
+};
+
+// Initialized but not started, so it can warm up first.
+struct WarmUpPipeline {
+    std::shared_ptr<CountingSource> source = std::make_shared<CountingSource>("Source");
+    std::shared_ptr<ForwardingStage> stage = std::make_shared<ForwardingStage>("Stage");
+    std::shared_ptr<CountingSink> sink = std::make_shared<CountingSink>("Sink");
+    TestPipeline pipeline{{source, stage, sink}, {{"Source", "Stage"}, {"Stage", "Sink"}}, false};
+};
+} // namespace
+
+TEST(WarmUpTest, SamplesStopAtTheSinks) {
+    WarmUpPipeline test;
+    ASSERT_EQ(test.pipeline->WarmUp(20), ErrorCode::SUCCESS);
+    EXPECT_EQ(test.source->warmUpCount.load(), 20);
+    EXPECT_EQ(test.source->processCount.load(), 0);
+    EXPECT_EQ(test.stage->warmUpCount.load(), 20);
+    EXPECT_EQ(test.stage->lastWatermark.load(), 1020u);
+    EXPECT_EQ(test.sink->receivedCount.load(), 0);
+}
+
+TEST(WarmUpTest, PipelineGoesLiveAfterwards) {
+    WarmUpPipeline test;
+    ASSERT_EQ(test.pipeline->WarmUp(5), ErrorCode::SUCCESS);
+    test.pipeline.Start();
+
+    // The watermarks of the samples are forgotten, the live ones are behind them.
+    EXPECT_TRUE(WaitFor([&test]() { return test.sink->receivedCount.load() >= 5 && test.stage->lastWatermark.load() < 1000; }));
+    EXPECT_GE(test.sink->receivedCount.load(), 5);
+    EXPECT_LT(test.stage->lastWatermark.load(), 1000u);
+    EXPECT_EQ(test.stage->warmUpCount.load(), 5);
+    EXPECT_GE(test.stage->processCount.load(), 5);
+
+    EXPECT_EQ(test.pipeline->WarmUp(5), ErrorCode::FAILED_ALREADY_START);
+}